@@ -0,0 +1,368 @@
+#ifndef CHUNKED_LIST_HPP
+#define CHUNKED_LIST_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// list stored as a sequence of chunks (up to ChunkSize items each) with a Fenwick tree of chunk sizes
+// - insert/erase: O(ChunkSize + log n) - items are shifted only inside a chunk
+//   except a split of a full chunk or a removal of an empty chunk: O(n / ChunkSize) - the vector of chunks
+//   is shifted and the index is rebuilt (a split happens at most once per ChunkSize / 2 inserts into a chunk)
+// - it += n: O(log n) - a chunk is found by a search in the Fenwick tree
+// - iterators are bidirectional + operator+=/-=; unlike std::list iterators they are
+//   invalidated by insert and erase
+
+template <typename T, size_t ChunkSize = 64>
+class chunked_list
+{
+    static_assert(ChunkSize >= 2, "chunk must hold at least two items");
+
+    std::vector<std::vector<T>> chunks_; // never contains an empty chunk
+    std::vector<size_t> tree_;           // Fenwick tree (1-based) of chunk sizes
+    size_t size_{};
+
+    void rebuild_index()
+    {
+        tree_.assign(chunks_.size() + 1, 0);
+
+        for (size_t i = 1; i < tree_.size(); ++i)
+        {
+            tree_[i] += chunks_[i - 1].size();
+            if (const size_t parent = i + (i & (~i + 1)); parent < tree_.size())
+                tree_[parent] += tree_[i];
+        }
+    }
+
+    // O(log n) - a new chunk at the end covers a range of already indexed chunks
+    void append_to_index(size_t chunk_size)
+    {
+        if (tree_.empty())
+            tree_.push_back(0);
+
+        const size_t i = tree_.size();
+        tree_.push_back(chunk_size + items_before(i - 1) - items_before(i - (i & (~i + 1))));
+    }
+
+    void update_index(size_t chunk, std::make_signed_t<size_t> delta)
+    {
+        for (size_t i = chunk + 1; i < tree_.size(); i += i & (~i + 1))
+            tree_[i] += delta;
+    }
+
+    // number of items in chunks [0, chunk)
+    size_t items_before(size_t chunk) const
+    {
+        size_t count = 0;
+        for (size_t i = chunk; i > 0; i -= i & (~i + 1))
+            count += tree_[i];
+        return count;
+    }
+
+    // chunk & offset of the item at position pos (pos < size())
+    std::pair<size_t, size_t> locate(size_t pos) const
+    {
+        size_t chunk = 0;
+        size_t step = 1;
+        while (step * 2 < tree_.size())
+            step *= 2;
+
+        for (; step > 0; step /= 2)
+        {
+            if (chunk + step < tree_.size() && tree_[chunk + step] <= pos)
+            {
+                chunk += step;
+                pos -= tree_[chunk];
+            }
+        }
+
+        return {chunk, pos};
+    }
+
+    template <bool IsConst>
+    class basic_iterator
+    {
+        friend class chunked_list;
+
+        template <bool>
+        friend class basic_iterator;
+
+        using TList = std::conditional_t<IsConst, const chunked_list, chunked_list>;
+
+        TList* list_{};
+        size_t chunk_{};
+        size_t offset_{};
+
+        basic_iterator(TList* list, size_t chunk, size_t offset)
+            : list_{list}
+            , chunk_{chunk}
+            , offset_{offset}
+        {
+        }
+
+        size_t position() const
+        {
+            return list_->items_before(chunk_) + offset_;
+        }
+
+        void seek(size_t pos)
+        {
+            if (pos == list_->size_)
+                *this = list_->template end_iterator<IsConst>();
+            else
+                std::tie(chunk_, offset_) = list_->locate(pos);
+        }
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        basic_iterator() = default;
+
+        operator basic_iterator<true>() const
+        {
+            return {list_, chunk_, offset_};
+        }
+
+        reference operator*() const
+        {
+            return list_->chunks_[chunk_][offset_];
+        }
+
+        pointer operator->() const
+        {
+            return &**this;
+        }
+
+        basic_iterator& operator++()
+        {
+            if (++offset_ == list_->chunks_[chunk_].size())
+            {
+                ++chunk_;
+                offset_ = 0;
+            }
+            return *this;
+        }
+
+        basic_iterator operator++(int)
+        {
+            auto temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        basic_iterator& operator--()
+        {
+            if (offset_ == 0)
+                offset_ = list_->chunks_[--chunk_].size();
+            --offset_;
+            return *this;
+        }
+
+        basic_iterator operator--(int)
+        {
+            auto temp = *this;
+            --*this;
+            return temp;
+        }
+
+        basic_iterator& operator+=(difference_type n)
+        {
+            // short jumps stay in the current chunk
+            if (chunk_ < list_->chunks_.size())
+            {
+                const auto new_offset = static_cast<difference_type>(offset_) + n;
+                if (new_offset >= 0 && new_offset < static_cast<difference_type>(list_->chunks_[chunk_].size()))
+                {
+                    offset_ = new_offset;
+                    return *this;
+                }
+            }
+
+            seek(position() + n);
+            return *this;
+        }
+
+        basic_iterator& operator-=(difference_type n)
+        {
+            return *this += -n;
+        }
+
+        friend basic_iterator operator+(basic_iterator it, difference_type n)
+        {
+            return it += n;
+        }
+
+        friend basic_iterator operator-(basic_iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const basic_iterator& a, const basic_iterator& b)
+        {
+            return static_cast<difference_type>(a.position()) - static_cast<difference_type>(b.position());
+        }
+
+        bool operator==(const basic_iterator& other) const
+        {
+            return chunk_ == other.chunk_ && offset_ == other.offset_;
+        }
+    };
+
+    template <bool IsConst>
+    basic_iterator<IsConst> end_iterator() const
+    {
+        using TList = typename basic_iterator<IsConst>::TList;
+        return {const_cast<TList*>(this), chunks_.size(), 0};
+    }
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    chunked_list() = default;
+
+    chunked_list(std::initializer_list<T> items)
+    {
+        for (const auto& item : items)
+            push_back(item);
+    }
+
+    template <std::input_iterator TIterator>
+    chunked_list(TIterator first, TIterator last)
+    {
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    iterator begin() { return {this, 0, 0}; }
+    iterator end() { return end_iterator<false>(); }
+    const_iterator begin() const { return {this, 0, 0}; }
+    const_iterator end() const { return end_iterator<true>(); }
+
+    T& front() { return chunks_.front().front(); }
+    T& back() { return chunks_.back().back(); }
+
+    T& operator[](size_t pos)
+    {
+        const auto [chunk, offset] = locate(pos);
+        return chunks_[chunk][offset];
+    }
+
+    const T& operator[](size_t pos) const
+    {
+        const auto [chunk, offset] = locate(pos);
+        return chunks_[chunk][offset];
+    }
+
+    iterator insert(const_iterator pos, T value)
+    {
+        size_t chunk = pos.chunk_;
+        size_t offset = pos.offset_;
+
+        if (chunk == chunks_.size()) // end() - append to the last chunk
+        {
+            if (chunks_.empty() || chunks_.back().size() == ChunkSize)
+            {
+                chunks_.emplace_back().reserve(ChunkSize);
+                chunks_.back().push_back(std::move(value));
+                ++size_;
+                append_to_index(1);
+                return {this, chunks_.size() - 1, 0};
+            }
+
+            chunk = chunks_.size() - 1;
+            offset = chunks_[chunk].size();
+        }
+
+        auto& items = chunks_[chunk];
+        items.insert(items.begin() + offset, std::move(value));
+        ++size_;
+
+        if (items.size() <= ChunkSize)
+        {
+            update_index(chunk, 1);
+            return {this, chunk, offset};
+        }
+
+        // split an overflowing chunk into halves
+        const size_t half = items.size() / 2;
+        std::vector<T> upper;
+        upper.reserve(ChunkSize);
+        upper.insert(upper.end(), std::make_move_iterator(items.begin() + half), std::make_move_iterator(items.end()));
+        items.erase(items.begin() + half, items.end());
+        chunks_.insert(chunks_.begin() + chunk + 1, std::move(upper));
+        rebuild_index();
+
+        if (offset < half)
+            return {this, chunk, offset};
+        return {this, chunk + 1, offset - half};
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        const size_t chunk = pos.chunk_;
+        const size_t offset = pos.offset_;
+
+        auto& items = chunks_[chunk];
+        items.erase(items.begin() + offset);
+        --size_;
+
+        if (items.empty())
+        {
+            chunks_.erase(chunks_.begin() + chunk);
+            rebuild_index();
+            return {this, chunk, 0};
+        }
+
+        update_index(chunk, -1);
+
+        if (offset == items.size())
+            return {this, chunk + 1, 0};
+        return {this, chunk, offset};
+    }
+
+    void push_back(T value)
+    {
+        insert(end(), std::move(value));
+    }
+
+    void push_front(T value)
+    {
+        insert(begin(), std::move(value));
+    }
+
+    void pop_back()
+    {
+        erase(std::prev(end()));
+    }
+
+    void pop_front()
+    {
+        erase(begin());
+    }
+
+    void clear()
+    {
+        chunks_.clear();
+        tree_.clear();
+        size_ = 0;
+    }
+};
+
+#endif
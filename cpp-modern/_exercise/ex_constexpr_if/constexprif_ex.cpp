@@ -1,7 +1,18 @@
 #include "catch.hpp"
+#include "chunked_list.hpp"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <forward_list>
 #include <iostream>
+#include <iterator>
 #include <list>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 using namespace std;
@@ -14,6 +25,10 @@ struct SlowPath
 {
 };
 
+struct ContiguousPath
+{
+};
+
 template <typename TIterator>
 auto advance_it(TIterator& it, int count)
 {
@@ -24,6 +39,11 @@ auto advance_it(TIterator& it, int count)
         it += count;
         return FastPath();
     }
+    else if constexpr (requires { it += count; })
+    {
+        it += count; // bidirectional iterators with a seek operation - e.g. chunked_list
+        return FastPath();
+    }
     else
     {
         for (int i = 0; i < count; ++i)
@@ -32,6 +52,47 @@ auto advance_it(TIterator& it, int count)
     }
 }
 
+// counts steps of an iterator - ++it or it += n is one step
+template <typename TIterator>
+class step_counting_iterator
+{
+    TIterator it_;
+    size_t* steps_;
+
+public:
+    using iterator_category = typename std::iterator_traits<TIterator>::iterator_category;
+    using value_type = typename std::iterator_traits<TIterator>::value_type;
+    using difference_type = typename std::iterator_traits<TIterator>::difference_type;
+    using pointer = typename std::iterator_traits<TIterator>::pointer;
+    using reference = typename std::iterator_traits<TIterator>::reference;
+
+    step_counting_iterator(TIterator it, size_t& steps)
+        : it_{it}
+        , steps_{&steps}
+    {
+    }
+
+    reference operator*() const
+    {
+        return *it_;
+    }
+
+    step_counting_iterator& operator++()
+    {
+        ++*steps_;
+        ++it_;
+        return *this;
+    }
+
+    step_counting_iterator& operator+=(difference_type n)
+        requires requires(TIterator& it) { it += n; }
+    {
+        ++*steps_;
+        it_ += n;
+        return *this;
+    }
+};
+
 TEST_CASE("constexpr-if with iterator categories")
 {
     SECTION("random_access_iterator")
@@ -59,4 +120,362 @@ TEST_CASE("constexpr-if with iterator categories")
 
         REQUIRE(*it == 4);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("chunked_list")
+{
+    chunked_list<int, 4> data = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+    REQUIRE(data.size() == 10);
+    REQUIRE(vector<int>(data.begin(), data.end()) == vector{1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+
+    SECTION("advance_it seeks in O(log n)")
+    {
+        auto it = data.begin();
+
+        auto result = advance_it(it, 7);
+
+        static_assert(std::is_same_v<decltype(result), FastPath>);
+        static_assert(std::bidirectional_iterator<decltype(it)>);
+
+        REQUIRE(*it == 8);
+
+        it -= 6;
+        REQUIRE(*it == 2);
+
+        it += 9;
+        REQUIRE(it == data.end());
+        REQUIRE(it - data.begin() == 10);
+    }
+
+    SECTION("insert & erase")
+    {
+        auto it = data.begin() + 5;
+        it = data.insert(it, 42);
+        REQUIRE(*it == 42);
+
+        data.push_front(0);
+        data.push_back(11);
+
+        REQUIRE(vector<int>(data.begin(), data.end()) == vector{0, 1, 2, 3, 4, 5, 42, 6, 7, 8, 9, 10, 11});
+        REQUIRE(data[6] == 42);
+
+        it = data.erase(data.begin() + 6);
+        REQUIRE(*it == 6);
+
+        while (data.size() > 2)
+            data.erase(data.begin() + 1);
+
+        REQUIRE(vector<int>(data.begin(), data.end()) == vector{0, 11});
+        REQUIRE(*(data.end() - 1) == 11);
+    }
+
+    SECTION("the same positions as std::list for 1M items")
+    {
+        constexpr int size = 1'000'000;
+
+        list<int> std_list;
+        chunked_list<int> indexed_list;
+        for (int i = 0; i < size; ++i)
+        {
+            std_list.push_back(i);
+            indexed_list.push_back(i);
+        }
+
+        for (int count : {0, 1, 63, 64, 65, 777'777, size - 1})
+        {
+            auto std_it = std_list.begin();
+            auto indexed_it = indexed_list.begin();
+
+            advance_it(std_it, count);
+            advance_it(indexed_it, count);
+
+            REQUIRE(*indexed_it == *std_it);
+        }
+    }
+
+    SECTION("step counts - std::list vs. chunked_list")
+    {
+        list<int> std_list(10'000);
+        chunked_list<int> indexed_list(std_list.begin(), std_list.end());
+
+        for (int count : {0, 1, 64, 9'999})
+        {
+            size_t std_steps = 0;
+            size_t indexed_steps = 0;
+            step_counting_iterator std_it{std_list.begin(), std_steps};
+            step_counting_iterator indexed_it{indexed_list.begin(), indexed_steps};
+
+            static_assert(std::is_same_v<decltype(advance_it(std_it, count)), SlowPath>);
+            static_assert(std::is_same_v<decltype(advance_it(indexed_it, count)), FastPath>);
+
+            advance_it(std_it, count);
+            advance_it(indexed_it, count);
+
+            REQUIRE(std_steps == static_cast<size_t>(count));
+            REQUIRE(indexed_steps == 1);
+        }
+    }
+}
+
+TEST_CASE("advance_it - std::list vs. chunked_list", "[.][benchmark]")
+{
+    constexpr int size = 1'000'000;
+    constexpr int repetitions = 100;
+
+    chunked_list<int> indexed_list;
+    for (int i = 0; i < size; ++i)
+        indexed_list.push_back(i);
+    list<int> std_list(indexed_list.begin(), indexed_list.end());
+
+    auto measure = [](auto& container, std::string_view desc) {
+        const auto start = std::chrono::high_resolution_clock::now();
+
+        long long checksum = 0;
+        for (int i = 1; i <= repetitions; ++i)
+        {
+            auto it = container.begin();
+            advance_it(it, size - i);
+            checksum += *it;
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now() - start);
+
+        size_t steps = 0;
+        step_counting_iterator counting_it{container.begin(), steps};
+        advance_it(counting_it, size - 1);
+
+        std::cout << desc << ": " << elapsed.count() / repetitions << "ns, " << steps << " steps per advance_it(it, ~" << size
+                  << ") - checksum: " << checksum << "\n";
+    };
+
+    measure(std_list, "std::list    - ++it x count");
+    measure(indexed_list, "chunked_list - it += count");
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+// iterator-category algorithm layer
+// - ContiguousPath - contiguous memory of trivially copyable items: memmove/memset/memchr
+// - FastPath       - random access iterators: loops with a precomputed count
+// - SlowPath       - other iterators: ++it until last
+
+template <typename TIterator>
+constexpr bool is_random_access_v = std::is_base_of_v<std::random_access_iterator_tag,
+    typename std::iterator_traits<TIterator>::iterator_category>;
+
+template <typename TIterator>
+concept TriviallyContiguous = std::contiguous_iterator<TIterator>
+    && std::is_trivially_copyable_v<std::iter_value_t<TIterator>>;
+
+template <typename TIterator>
+concept ByteContiguous = TriviallyContiguous<TIterator>
+    && sizeof(std::iter_value_t<TIterator>) == 1;
+
+template <typename TInIterator, typename TOutIterator>
+concept MemmoveCopyable = TriviallyContiguous<TInIterator> && std::contiguous_iterator<TOutIterator>
+    && std::is_same_v<std::iter_value_t<TInIterator>, std::iter_value_t<TOutIterator>>;
+
+template <typename TIterator, typename T>
+concept MemsetFillable = ByteContiguous<TIterator> && std::is_convertible_v<T, std::iter_value_t<TIterator>>;
+
+template <typename TIterator, typename T>
+concept MemchrSearchable = ByteContiguous<TIterator> && std::is_integral_v<std::iter_value_t<TIterator>>
+    && std::is_integral_v<T>;
+
+template <typename TIterator>
+auto distance_it(TIterator first, TIterator last)
+{
+    using TDifference = typename std::iterator_traits<TIterator>::difference_type;
+
+    if constexpr (is_random_access_v<TIterator>)
+    {
+        return std::pair{TDifference(last - first), FastPath()};
+    }
+    else
+    {
+        TDifference count = 0;
+        for (; first != last; ++first)
+            ++count;
+        return std::pair{count, SlowPath()};
+    }
+}
+
+template <typename TInIterator, typename TOutIterator>
+auto copy_it(TInIterator first, TInIterator last, TOutIterator dest)
+{
+    if constexpr (MemmoveCopyable<TInIterator, TOutIterator>)
+    {
+        const auto count = last - first;
+        if (count > 0)
+            std::memmove(std::to_address(dest), std::to_address(first), count * sizeof(std::iter_value_t<TInIterator>));
+        return std::pair{dest + count, ContiguousPath()};
+    }
+    else if constexpr (is_random_access_v<TInIterator>)
+    {
+        for (auto count = last - first; count > 0; --count)
+            *dest++ = *first++;
+        return std::pair{dest, FastPath()};
+    }
+    else
+    {
+        for (; first != last; ++first)
+            *dest++ = *first;
+        return std::pair{dest, SlowPath()};
+    }
+}
+
+template <typename TIterator, typename T>
+auto fill_it(TIterator first, TIterator last, const T& value)
+{
+    if constexpr (MemsetFillable<TIterator, T>)
+    {
+        const std::iter_value_t<TIterator> item = value;
+        unsigned char byte;
+        std::memcpy(&byte, &item, 1);
+
+        if (last - first > 0)
+            std::memset(std::to_address(first), byte, last - first);
+        return ContiguousPath();
+    }
+    else if constexpr (is_random_access_v<TIterator>)
+    {
+        for (auto count = last - first; count > 0; --count)
+            *first++ = value;
+        return FastPath();
+    }
+    else
+    {
+        for (; first != last; ++first)
+            *first = value;
+        return SlowPath();
+    }
+}
+
+template <typename TIterator, typename T>
+auto find_it(TIterator first, TIterator last, const T& value)
+{
+    if constexpr (MemchrSearchable<TIterator, T>)
+    {
+        using TValue = std::iter_value_t<TIterator>;
+
+        const TValue item = static_cast<TValue>(value);
+
+        // items equal to value (compared like *first == value - after the usual arithmetic conversions)
+        // are exactly the items equal to item - if item != value no item can be found
+        if (!(item == value) || last - first <= 0)
+            return std::pair{last, ContiguousPath()};
+
+        unsigned char byte;
+        std::memcpy(&byte, &item, 1);
+
+        const void* pos = std::memchr(std::to_address(first), byte, last - first);
+        if (pos == nullptr)
+            return std::pair{last, ContiguousPath()};
+
+        return std::pair{first + (static_cast<const unsigned char*>(pos) - reinterpret_cast<const unsigned char*>(std::to_address(first))),
+            ContiguousPath()};
+    }
+    else if constexpr (is_random_access_v<TIterator>)
+    {
+        for (auto count = last - first; count > 0; --count, ++first)
+            if (*first == value)
+                break;
+        return std::pair{first, FastPath()};
+    }
+    else
+    {
+        for (; first != last; ++first)
+            if (*first == value)
+                break;
+        return std::pair{first, SlowPath()};
+    }
+}
+
+TEST_CASE("iterator-category algorithm layer")
+{
+    const vector<int> numbers = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    const list<int> numbers_list(numbers.begin(), numbers.end());
+
+    SECTION("distance_it")
+    {
+        auto [vec_distance, vec_path] = distance_it(numbers.begin(), numbers.end());
+        static_assert(std::is_same_v<decltype(vec_path), FastPath>);
+        REQUIRE(vec_distance == 10);
+
+        auto [list_distance, list_path] = distance_it(numbers_list.begin(), numbers_list.end());
+        static_assert(std::is_same_v<decltype(list_path), SlowPath>);
+        REQUIRE(list_distance == 10);
+    }
+
+    SECTION("copy_it")
+    {
+        vector<int> target(10);
+
+        auto [end, path] = copy_it(numbers.begin(), numbers.end(), target.begin());
+        static_assert(std::is_same_v<decltype(path), ContiguousPath>);
+        REQUIRE(end == target.end());
+        REQUIRE(target == numbers);
+
+        vector<std::string> words = {"one", "two"};
+        vector<std::string> target_words(2);
+        auto [words_end, words_path] = copy_it(words.begin(), words.end(), target_words.begin());
+        static_assert(std::is_same_v<decltype(words_path), FastPath>); // std::string is not trivially copyable
+        REQUIRE(target_words == words);
+
+        vector<int> from_list;
+        auto [list_end, list_path] = copy_it(numbers_list.begin(), numbers_list.end(), back_inserter(from_list));
+        static_assert(std::is_same_v<decltype(list_path), SlowPath>);
+        REQUIRE(from_list == numbers);
+    }
+
+    SECTION("fill_it")
+    {
+        std::array<char, 8> buffer{};
+        auto path = fill_it(buffer.begin(), buffer.end(), '*');
+        static_assert(std::is_same_v<decltype(path), ContiguousPath>);
+        REQUIRE(std::string(buffer.begin(), buffer.end()) == "********");
+
+        vector<int> ints(5);
+        auto int_path = fill_it(ints.begin(), ints.end(), -1);
+        static_assert(std::is_same_v<decltype(int_path), FastPath>);
+        REQUIRE(ints == vector{-1, -1, -1, -1, -1});
+
+        std::forward_list<int> fwd_list(3);
+        auto fwd_list_path = fill_it(fwd_list.begin(), fwd_list.end(), 7);
+        static_assert(std::is_same_v<decltype(fwd_list_path), SlowPath>);
+        REQUIRE(fwd_list == std::forward_list{7, 7, 7});
+    }
+
+    SECTION("find_it")
+    {
+        const std::string text = "constexpr if";
+
+        auto [pos, path] = find_it(text.begin(), text.end(), 'x');
+        static_assert(std::is_same_v<decltype(path), ContiguousPath>);
+        REQUIRE(pos - text.begin() == 6);
+
+        auto [not_found, not_found_path] = find_it(text.begin(), text.end(), 'z');
+        REQUIRE(not_found == text.end());
+
+        auto [out_of_range, out_of_range_path] = find_it(text.begin(), text.end(), 'x' + 256);
+        REQUIRE(out_of_range == text.end());
+
+        // the same result as *it == value - a signed char -56 is not equal to an unsigned char 200
+        const std::string bytes = "byte \xC8";
+        const auto byte_200 = static_cast<unsigned char>(200);
+        auto [byte_pos, byte_path] = find_it(bytes.begin(), bytes.end(), byte_200);
+        REQUIRE(byte_pos == std::find(bytes.begin(), bytes.end(), byte_200));
+
+        auto [char_pos, char_path] = find_it(bytes.begin(), bytes.end(), '\xC8');
+        REQUIRE(char_pos - bytes.begin() == 5);
+
+        auto [vec_pos, vec_path] = find_it(numbers.begin(), numbers.end(), 4);
+        static_assert(std::is_same_v<decltype(vec_path), FastPath>);
+        REQUIRE(*vec_pos == 4);
+
+        auto [list_pos, list_path] = find_it(numbers_list.begin(), numbers_list.end(), 4);
+        static_assert(std::is_same_v<decltype(list_path), SlowPath>);
+        REQUIRE(*list_pos == 4);
+    }
+}
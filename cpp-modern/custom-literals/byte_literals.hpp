@@ -0,0 +1,127 @@
+#ifndef BYTE_LITERALS_HPP
+#define BYTE_LITERALS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#include "fixed_string.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// string literals parsed at compile time into std::array<std::byte, N>
+// - literal operator templates take a string as a template parameter (C++20) - N depends on the text
+// - parsers are consteval: a malformed constant is a throw in constant evaluation, i.e. a compile error
+
+namespace ByteLiterals
+{
+    namespace Details
+    {
+        consteval unsigned hex_digit(char c)
+        {
+            if (c >= '0' && c <= '9')
+                return c - '0';
+            if (c >= 'a' && c <= 'f')
+                return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F')
+                return c - 'A' + 10;
+
+            throw "invalid hex digit";
+        }
+
+        template <size_t Bytes, size_t N>
+        consteval std::array<std::byte, Bytes> parse_hex(const FixedString<N>& str)
+        {
+            if (str.size() != 2 * Bytes)
+                throw "invalid number of hex digits";
+
+            std::array<std::byte, Bytes> bytes{};
+            for (size_t i = 0; i < Bytes; ++i)
+                bytes[i] = std::byte(hex_digit(str[2 * i]) << 4 | hex_digit(str[2 * i + 1]));
+
+            return bytes;
+        }
+    }
+
+    // "deadbeef"_hex -> {0xde, 0xad, 0xbe, 0xef}
+    template <FixedString Str>
+    consteval auto operator""_hex()
+    {
+        static_assert(Str.size() % 2 == 0, "hex literal must have an even number of digits");
+
+        return Details::parse_hex<Str.size() / 2>(Str);
+    }
+
+    // 64 hex digits of SHA-256 digest -> 32 bytes
+    template <FixedString Str>
+    consteval auto operator""_sha256()
+    {
+        static_assert(Str.size() == 64, "SHA-256 digest must have 64 hex digits");
+
+        return Details::parse_hex<32>(Str);
+    }
+
+    // "10.0.0.1"_ipv4 -> {10, 0, 0, 1}
+    template <FixedString Str>
+    consteval auto operator""_ipv4()
+    {
+        std::array<std::byte, 4> address{};
+
+        size_t octet = 0;
+        size_t digits = 0;
+        unsigned value = 0;
+
+        for (size_t i = 0; i <= Str.size(); ++i)
+        {
+            const char c = i < Str.size() ? Str[i] : '.';
+
+            if (c == '.')
+            {
+                if (digits == 0 || octet == 4)
+                    throw "invalid IPv4 address";
+
+                address[octet++] = std::byte(value);
+                digits = 0;
+                value = 0;
+            }
+            else if (c >= '0' && c <= '9')
+            {
+                if (digits > 0 && value == 0)
+                    throw "leading zero in IPv4 octet";
+
+                value = value * 10 + (c - '0');
+                ++digits;
+
+                if (value > 255)
+                    throw "IPv4 octet out of range";
+            }
+            else
+                throw "invalid character in IPv4 address";
+        }
+
+        if (octet != 4)
+            throw "IPv4 address must have 4 octets";
+
+        return address;
+    }
+
+    // "00:1a:2b:3c:4d:5e"_mac -> 6 bytes
+    template <FixedString Str>
+    consteval auto operator""_mac()
+    {
+        static_assert(Str.size() == 17, "MAC address must have the form xx:xx:xx:xx:xx:xx");
+
+        std::array<std::byte, 6> address{};
+
+        for (size_t i = 0; i < 6; ++i)
+        {
+            if (i > 0 && Str[3 * i - 1] != ':' && Str[3 * i - 1] != '-')
+                throw "invalid MAC address separator";
+
+            address[i] = std::byte(Details::hex_digit(Str[3 * i]) << 4 | Details::hex_digit(Str[3 * i + 1]));
+        }
+
+        return address;
+    }
+}
+
+#endif
@@ -1,12 +1,21 @@
+#include "byte_literals.hpp"
 #include "catch.hpp"
+#include "format_literals.hpp"
+#include "timing.hpp"
+#include "units.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <chrono>
 #include <iostream>
 #include <list>
 #include <map>
 #include <numeric>
+#include <sstream>
+#include <span>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -23,4 +32,282 @@ namespace Unsafe
 TEST_CASE("unsafe code")
 {
     double speed = Unsafe::calculate_speed(100.0, 10.0);
-}
\ No newline at end of file
+}
+
+namespace Safe
+{
+    Units::Speed calculate_speed(Units::Length distance, Units::Time time)
+    {
+        return distance / time;
+    }
+}
+
+TEST_CASE("units - safe code")
+{
+    using namespace Units::Literals;
+
+    Units::Speed speed = Safe::calculate_speed(100.0_km, 2.0_h);
+
+    REQUIRE(speed.in(1.0_kmph) == Approx(50.0));
+    REQUIRE(speed.value() == Approx(13.8889)); // m/s
+
+    // Safe::calculate_speed(2.0_h, 100.0_km); // ERROR - no conversion from Time to Length
+
+    SECTION("conversions are resolved at compile time")
+    {
+        static_assert(2.0_h == 7200.0_s);
+        static_assert(1.5_km == 1500_m);
+        static_assert(90_min == 1.5_h);
+        static_assert((100.0_km / 2.0_h).in(1.0_kmph) == 50.0);
+        static_assert(std::is_same_v<decltype(10.0_m / (2.0_s * 1.0_s)), Units::Acceleration>);
+    }
+
+    SECTION("arithmetic")
+    {
+        auto distance = 1.0_km + 500.0_m;
+        distance -= 250_m;
+
+        REQUIRE(distance == 1250.0_m);
+        REQUIRE(distance > 1.0_km);
+        REQUIRE(2 * distance == 2.5_km);
+        REQUIRE((-distance).value() == -1250.0);
+    }
+}
+
+TEST_CASE("units - batch kernels")
+{
+    using namespace Units::Literals;
+
+    std::vector<Units::Length> distances = {100.0_km, 1.0_km, 42.195_km};
+    std::vector<Units::Time> times = {2.0_h, 1.0_min, 7200.0_s};
+    std::vector<Units::Speed> speeds(3);
+
+    Units::divide(std::span<const Units::Length>{distances}, std::span<const Units::Time>{times}, std::span{speeds});
+
+    REQUIRE(speeds[0].in(1.0_kmph) == Approx(50.0));
+    REQUIRE(speeds[1].in(1.0_kmph) == Approx(60.0));
+    REQUIRE(speeds[2].in(1.0_kmph) == Approx(21.0975));
+
+    REQUIRE(Units::sum(std::span<const Units::Length>{distances}).in(1.0_km) == Approx(143.195));
+}
+
+TEST_CASE("units - quantities vs. raw doubles", "[.][benchmark]")
+{
+    using namespace Units::Literals;
+
+    constexpr size_t size = 10'000'000;
+
+    std::vector<double> raw_distances(size, 100.0), raw_times(size, 2.0), raw_speeds(size);
+    std::vector<Units::Length> distances(size, 100.0_km);
+    std::vector<Units::Time> times(size, 2.0_h);
+    std::vector<Units::Speed> speeds(size);
+
+    auto measure = [](std::string_view desc, auto action) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        action();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - start);
+        std::cout << desc << ": " << elapsed.count() << "us\n";
+    };
+
+    measure("raw doubles", [&] {
+        for (size_t i = 0; i < size; ++i)
+            raw_speeds[i] = Unsafe::calculate_speed(raw_distances[i], raw_times[i]);
+    });
+
+    measure("quantities ", [&] {
+        Units::divide(std::span<const Units::Length>{distances}, std::span<const Units::Time>{times}, std::span{speeds});
+    });
+}
+
+TEST_CASE("byte literals parsed at compile time")
+{
+    using namespace ByteLiterals;
+
+    SECTION("hex")
+    {
+        constexpr auto blob = "deadBEEF"_hex;
+
+        static_assert(std::is_same_v<decltype(blob), const std::array<std::byte, 4>>);
+        static_assert(blob == std::array{std::byte{0xde}, std::byte{0xad}, std::byte{0xbe}, std::byte{0xef}});
+
+        // auto odd = "abc"_hex;   // ERROR - odd number of digits
+        // auto bad = "abcx"_hex;  // ERROR - invalid hex digit
+    }
+
+    SECTION("sha256")
+    {
+        constexpr auto digest = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"_sha256;
+
+        static_assert(digest.size() == 32);
+        static_assert(digest.front() == std::byte{0xe3});
+        static_assert(digest.back() == std::byte{0x55});
+    }
+
+    SECTION("ipv4")
+    {
+        constexpr auto address = "10.0.0.1"_ipv4;
+
+        static_assert(address == std::array{std::byte{10}, std::byte{0}, std::byte{0}, std::byte{1}});
+        static_assert("255.255.255.0"_ipv4[0] == std::byte{255});
+
+        // auto bad = "10.0.0.256"_ipv4; // ERROR - octet out of range
+        // auto bad = "10.0.0"_ipv4;     // ERROR - 4 octets required
+        // auto bad = "10.0.00.1"_ipv4;  // ERROR - leading zero
+    }
+
+    SECTION("mac")
+    {
+        constexpr auto address = "00:1a:2B:3c:4d:5e"_mac;
+
+        static_assert(address == "001a2b3c4d5e"_hex);
+        static_assert("00-1a-2b-3c-4d-5e"_mac == address);
+    }
+
+    SECTION("packet filter rule")
+    {
+        struct FilterRule
+        {
+            std::array<std::byte, 4> source;
+            std::array<std::byte, 4> mask;
+        };
+
+        constexpr FilterRule rule{"192.168.1.0"_ipv4, "255.255.255.0"_ipv4};
+
+        auto matches = [&rule](const std::array<std::byte, 4>& address) {
+            for (size_t i = 0; i < address.size(); ++i)
+                if ((address[i] & rule.mask[i]) != rule.source[i])
+                    return false;
+            return true;
+        };
+
+        REQUIRE(matches("192.168.1.42"_ipv4));
+        REQUIRE_FALSE(matches("192.168.2.42"_ipv4));
+    }
+}
+
+TEST_CASE("format literals parsed at compile time")
+{
+    using namespace FormatLiterals;
+
+    SECTION("format_to a caller's buffer")
+    {
+        constexpr auto fmt = "temp={} monitor={}"_fmt;
+        static_assert(fmt.slots_count() == 2);
+
+        char buffer[64];
+        const auto [end, error_code] = fmt.format_to(std::begin(buffer), std::end(buffer), 23.88, "TempMonitor#1");
+
+        REQUIRE(error_code == std::errc{});
+        REQUIRE(std::string_view(buffer, end) == "temp=23.88 monitor=TempMonitor#1");
+
+        // fmt.format_to(std::begin(buffer), std::end(buffer), 23.88); // ERROR - number of args doesn't match slots
+        // auto bad = "temp={"_fmt;                                     // ERROR - unmatched '{'
+    }
+
+    SECTION("too small buffer")
+    {
+        char buffer[8];
+        const auto [end, error_code] = "temp={}"_fmt.format_to(std::begin(buffer), std::end(buffer), 123.456);
+
+        REQUIRE(error_code == std::errc::value_too_large);
+        REQUIRE(end == std::end(buffer));
+    }
+
+    SECTION("argument types & escaped braces")
+    {
+        REQUIRE("{}|{}|{}|{}|{}"_fmt(-42, 'c', true, "text"s, 1.5f) == "-42|c|true|text|1.5");
+        REQUIRE("{{{}}}"_fmt(7) == "{7}");
+        REQUIRE("no slots"_fmt() == "no slots");
+        REQUIRE("{}"_fmt(std::string(100, 'x')).size() == 100);
+    }
+}
+
+TEST_CASE("format literals vs. ostringstream & to_string", "[.][benchmark]")
+{
+    using namespace FormatLiterals;
+
+    constexpr int iterations = 1'000'000;
+    const double temp = 23.88;
+    const int monitor_id = 665;
+
+    auto measure = [](std::string_view desc, auto action) {
+        size_t total_size = 0;
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < iterations; ++i)
+            total_size += action();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now() - start);
+        std::cout << desc << ": " << elapsed.count() / iterations << "ns per message (" << total_size << ")\n";
+    };
+
+    measure("_fmt.format_to     ", [&] {
+        char buffer[64];
+        auto [end, error_code] = "temp={} monitor={}"_fmt.format_to(std::begin(buffer), std::end(buffer), temp, monitor_id);
+        return static_cast<size_t>(end - buffer);
+    });
+
+    measure("std::ostringstream ", [&] {
+        std::ostringstream out;
+        out << "temp=" << temp << " monitor=" << monitor_id;
+        return out.str().size();
+    });
+
+    measure("std::to_string +   ", [&] {
+        std::string msg = "temp=" + std::to_string(temp) + " monitor=" + std::to_string(monitor_id);
+        return msg.size();
+    });
+}
+
+TEST_CASE("scoped timers with chrono literals")
+{
+    Timing::reset();
+
+    for (int i = 0; i < 10; ++i)
+    {
+        auto t = Timing::timed("parse", 50us);
+
+        if (i == 0)
+            std::this_thread::sleep_for(1ms);
+    }
+
+    std::jthread other_thread{[] {
+        auto t = Timing::timed("parse", 50us);
+    }}; // stats of other_thread are flushed at thread exit
+    other_thread.join();
+
+    Timing::flush();
+
+    const auto sites = Timing::snapshot();
+    const auto& parse = sites.at("parse");
+
+    REQUIRE(parse.count == 11);
+    REQUIRE(parse.over_budget >= 1);
+    REQUIRE(parse.max() >= 1ms);
+    REQUIRE(parse.total() >= parse.max());
+    REQUIRE(std::accumulate(parse.buckets.begin(), parse.buckets.end(), 0ULL) == 11);
+
+    REQUIRE(Timing::SiteStats::bucket(0) == 0);
+    REQUIRE(Timing::SiteStats::bucket(1'500) == 11);
+    REQUIRE(Timing::SiteStats::bucket(UINT64_MAX) == Timing::SiteStats::buckets_count - 1); // the longest durations are not folded into bucket 0
+}
+
+TEST_CASE("overhead of scoped timers", "[.][benchmark]")
+{
+    constexpr int iterations = 10'000'000;
+
+    Timing::reset();
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        auto t = Timing::timed("empty scope", 50us);
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+
+    Timing::flush();
+
+    std::cout << "timed(): " << static_cast<double>(elapsed.count()) / iterations << "ns per scope"
+              << " - mean recorded: " << Timing::snapshot().at("empty scope").mean().count() << "ns\n";
+}
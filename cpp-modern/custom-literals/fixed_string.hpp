@@ -0,0 +1,30 @@
+#ifndef FIXED_STRING_HPP
+#define FIXED_STRING_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+// string literal usable as a template parameter - enables literal operator templates:
+// template <FixedString Str> consteval auto operator""_x();
+template <size_t N>
+struct FixedString
+{
+    char text[N]{};
+
+    constexpr FixedString(const char (&str)[N])
+    {
+        std::copy_n(str, N, text);
+    }
+
+    constexpr size_t size() const
+    {
+        return N - 1; // without '\0'
+    }
+
+    constexpr char operator[](size_t index) const
+    {
+        return text[index];
+    }
+};
+
+#endif
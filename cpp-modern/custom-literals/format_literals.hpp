@@ -0,0 +1,191 @@
+#ifndef FORMAT_LITERALS_HPP
+#define FORMAT_LITERALS_HPP
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include "fixed_string.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// "temp={} monitor={}"_fmt - format string parsed at compile time
+// - the string is split into literal chunks and {} slots (with {{ and }} escapes) by consteval code
+// - unmatched braces and a wrong number of arguments are compile errors
+// - formatting is only std::to_chars for numbers and memcpy for chunks & strings into a caller's buffer
+
+namespace FormatLiterals
+{
+    namespace Details
+    {
+        template <size_t N>
+        consteval size_t count_slots(const FixedString<N>& str)
+        {
+            size_t count = 0;
+
+            for (size_t i = 0; i < str.size(); ++i)
+            {
+                const bool has_next = i + 1 < str.size();
+
+                if (str[i] == '{')
+                {
+                    if (has_next && str[i + 1] == '}')
+                        ++count;
+                    else if (!(has_next && str[i + 1] == '{'))
+                        throw "invalid format string - unmatched '{'";
+                    ++i;
+                }
+                else if (str[i] == '}')
+                {
+                    if (!(has_next && str[i + 1] == '}'))
+                        throw "invalid format string - unmatched '}'";
+                    ++i;
+                }
+            }
+
+            return count;
+        }
+
+        template <size_t N, size_t SlotsCount>
+        struct ParsedFormat
+        {
+            std::array<char, N> text{}; // chunks without escapes, one after another
+            std::array<size_t, SlotsCount + 1> chunk_begin{};
+            std::array<size_t, SlotsCount + 1> chunk_size{};
+        };
+
+        template <size_t SlotsCount, size_t N>
+        consteval ParsedFormat<N, SlotsCount> parse(const FixedString<N>& str)
+        {
+            ParsedFormat<N, SlotsCount> parsed;
+
+            size_t text_size = 0;
+            size_t chunk = 0;
+
+            for (size_t i = 0; i < str.size(); ++i)
+            {
+                if (str[i] == '{' && str[i + 1] == '}') // slot - ends current chunk
+                {
+                    parsed.chunk_size[chunk] = text_size - parsed.chunk_begin[chunk];
+                    parsed.chunk_begin[++chunk] = text_size;
+                    ++i;
+                    continue;
+                }
+
+                parsed.text[text_size++] = str[i];
+
+                if (str[i] == '{' || str[i] == '}') // escaped brace
+                    ++i;
+            }
+
+            parsed.chunk_size[chunk] = text_size - parsed.chunk_begin[chunk];
+
+            return parsed;
+        }
+
+        inline bool append(char*& out, char* last, const char* data, size_t size)
+        {
+            if (static_cast<size_t>(last - out) < size)
+                return false;
+
+            std::memcpy(out, data, size);
+            out += size;
+            return true;
+        }
+
+        template <typename T>
+        bool append_arg(char*& out, char* last, const T& arg)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                return arg ? append(out, last, "true", 4) : append(out, last, "false", 5);
+            }
+            else if constexpr (std::is_same_v<T, char>)
+            {
+                return append(out, last, &arg, 1);
+            }
+            else if constexpr (std::is_arithmetic_v<T>)
+            {
+                const auto [end, error_code] = std::to_chars(out, last, arg);
+                if (error_code != std::errc{})
+                    return false;
+
+                out = end;
+                return true;
+            }
+            else
+            {
+                static_assert(std::is_convertible_v<const T&, std::string_view>, "unsupported type of a format argument");
+
+                const std::string_view text = arg;
+                return append(out, last, text.data(), text.size());
+            }
+        }
+    }
+
+    template <FixedString Str>
+    class Format
+    {
+        static constexpr size_t slots_count_ = Details::count_slots(Str);
+        static constexpr auto parsed_ = Details::parse<slots_count_>(Str);
+
+        static bool append_chunk(char*& out, char* last, size_t chunk)
+        {
+            return Details::append(out, last, parsed_.text.data() + parsed_.chunk_begin[chunk], parsed_.chunk_size[chunk]);
+        }
+
+    public:
+        static constexpr size_t slots_count()
+        {
+            return slots_count_;
+        }
+
+        // the same contract as std::to_chars - on error returns {last, std::errc::value_too_large}
+        template <typename... TArgs>
+        std::to_chars_result format_to(char* first, char* last, const TArgs&... args) const
+        {
+            static_assert(sizeof...(TArgs) == slots_count_, "number of arguments must match number of {} slots");
+
+            char* out = first;
+            size_t chunk = 0;
+
+            bool is_ok = append_chunk(out, last, chunk);
+            (..., (is_ok = is_ok && Details::append_arg(out, last, args) && append_chunk(out, last, ++chunk)));
+
+            if (!is_ok)
+                return {last, std::errc::value_too_large};
+
+            return {out, std::errc{}};
+        }
+
+        template <typename... TArgs>
+        std::string operator()(const TArgs&... args) const
+        {
+            std::string result(64, '\0');
+
+            while (true)
+            {
+                const auto [end, error_code] = format_to(result.data(), result.data() + result.size(), args...);
+                if (error_code == std::errc{})
+                {
+                    result.resize(end - result.data());
+                    return result;
+                }
+
+                result.resize(2 * result.size());
+            }
+        }
+    };
+
+    template <FixedString Str>
+    consteval auto operator""_fmt()
+    {
+        return Format<Str>{};
+    }
+}
+
+#endif
@@ -0,0 +1,259 @@
+#ifndef TIMING_HPP
+#define TIMING_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define TIMING_HAS_RDTSC
+#elif defined(__linux__)
+#include <time.h>
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// low-overhead scoped timers
+//   auto t = Timing::timed("parse", 50us);
+// - time is read from TSC (rdtsc) or CLOCK_MONOTONIC_RAW - ticks are converted to ns
+//   with a factor calibrated once - lazily on the first use, not during static initialization
+// - each thread aggregates per-site histograms (log2 buckets of ns) in thread local storage
+// - thread local stats are merged into a global registry every flush_interval and at thread exit
+
+namespace Timing
+{
+    using namespace std::literals;
+
+    constexpr auto flush_interval = 1s;
+
+    inline uint64_t now_ticks() noexcept
+    {
+#if defined(TIMING_HAS_RDTSC)
+        return __rdtsc();
+#elif defined(__linux__)
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000u + ts.tv_nsec;
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    namespace Details
+    {
+        inline double calibrate_ticks_per_ns()
+        {
+#if defined(TIMING_HAS_RDTSC)
+            const auto start_time = std::chrono::steady_clock::now();
+            const uint64_t start_ticks = now_ticks();
+
+            while (std::chrono::steady_clock::now() - start_time < 10ms)
+            {
+            }
+
+            const uint64_t end_ticks = now_ticks();
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time);
+
+            return static_cast<double>(end_ticks - start_ticks) / elapsed.count();
+#else
+            return 1.0; // ticks are nanoseconds
+#endif
+        }
+    }
+
+    inline double ticks_per_ns() noexcept
+    {
+        static const double factor = Details::calibrate_ticks_per_ns();
+        return factor;
+    }
+
+    inline std::chrono::nanoseconds ticks_to_duration(uint64_t ticks) noexcept
+    {
+        return std::chrono::nanoseconds(static_cast<int64_t>(ticks / ticks_per_ns()));
+    }
+
+    inline uint64_t duration_to_ticks(std::chrono::nanoseconds duration) noexcept
+    {
+        if (duration == std::chrono::nanoseconds::max())
+            return UINT64_MAX;
+        return static_cast<uint64_t>(duration.count() * ticks_per_ns());
+    }
+
+    struct SiteStats
+    {
+        static constexpr size_t buckets_count = 64;
+
+        uint64_t count{};
+        uint64_t total_ticks{};
+        uint64_t max_ticks{};
+        uint64_t over_budget{};
+        std::array<uint64_t, buckets_count> buckets{}; // bucket i: durations in [2^(i-1), 2^i) ns, the last one - all longer
+
+        static size_t bucket(uint64_t ns) noexcept
+        {
+            return std::min<size_t>(std::bit_width(ns), buckets_count - 1);
+        }
+
+        void record(uint64_t ticks, uint64_t budget_ticks) noexcept
+        {
+            ++count;
+            total_ticks += ticks;
+            max_ticks = std::max(max_ticks, ticks);
+            over_budget += ticks > budget_ticks;
+            ++buckets[bucket(static_cast<uint64_t>(ticks / ticks_per_ns()))];
+        }
+
+        void merge(const SiteStats& other) noexcept
+        {
+            count += other.count;
+            total_ticks += other.total_ticks;
+            max_ticks = std::max(max_ticks, other.max_ticks);
+            over_budget += other.over_budget;
+            for (size_t i = 0; i < buckets_count; ++i)
+                buckets[i] += other.buckets[i];
+        }
+
+        std::chrono::nanoseconds total() const { return ticks_to_duration(total_ticks); }
+        std::chrono::nanoseconds max() const { return ticks_to_duration(max_ticks); }
+        std::chrono::nanoseconds mean() const { return count ? ticks_to_duration(total_ticks / count) : 0ns; }
+    };
+
+    namespace Details
+    {
+        struct Registry
+        {
+            std::mutex mtx;
+            std::map<std::string, SiteStats> sites;
+        };
+
+        inline Registry& registry()
+        {
+            static Registry instance;
+            return instance;
+        }
+
+        // sites are identified by an address of a string literal - a few per thread, linear search is the fastest
+        class LocalStats
+        {
+            std::vector<std::pair<const char*, SiteStats>> sites_;
+            uint64_t next_flush_ticks_ = now_ticks() + duration_to_ticks(flush_interval);
+
+        public:
+            LocalStats()
+            {
+                registry(); // constructed before - destroyed after thread locals of the main thread
+            }
+
+            ~LocalStats()
+            {
+                flush();
+            }
+
+            SiteStats& site(const char* name)
+            {
+                for (auto& [site_name, stats] : sites_)
+                    if (site_name == name)
+                        return stats;
+
+                return sites_.emplace_back(name, SiteStats{}).second;
+            }
+
+            void record(const char* name, uint64_t ticks, uint64_t budget_ticks, uint64_t now)
+            {
+                site(name).record(ticks, budget_ticks);
+
+                if (now >= next_flush_ticks_)
+                {
+                    flush();
+                    next_flush_ticks_ = now + duration_to_ticks(flush_interval);
+                }
+            }
+
+            void flush()
+            {
+                auto& global = registry();
+
+                std::lock_guard lk{global.mtx};
+                for (auto& [name, stats] : sites_)
+                {
+                    if (stats.count > 0)
+                    {
+                        global.sites[name].merge(stats);
+                        stats = SiteStats{};
+                    }
+                }
+            }
+        };
+
+        inline LocalStats& local_stats()
+        {
+            thread_local LocalStats stats;
+            return stats;
+        }
+    }
+
+    class ScopedTimer
+    {
+        const char* site_;
+        uint64_t budget_ticks_;
+        uint64_t start_ticks_;
+
+    public:
+        ScopedTimer(const char* site, std::chrono::nanoseconds budget)
+            : site_{site}
+            , budget_ticks_{duration_to_ticks(budget)}
+            , start_ticks_{now_ticks()}
+        {
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        ~ScopedTimer()
+        {
+            const uint64_t end_ticks = now_ticks();
+            Details::local_stats().record(site_, end_ticks - start_ticks_, budget_ticks_, end_ticks);
+        }
+    };
+
+    // site must be a string literal (or other string with static storage duration)
+    inline ScopedTimer timed(const char* site, std::chrono::nanoseconds budget = std::chrono::nanoseconds::max())
+    {
+        return ScopedTimer{site, budget};
+    }
+
+    // merges stats of the calling thread into the global registry
+    inline void flush()
+    {
+        Details::local_stats().flush();
+    }
+
+    inline std::map<std::string, SiteStats> snapshot()
+    {
+        auto& global = Details::registry();
+
+        std::lock_guard lk{global.mtx};
+        return global.sites;
+    }
+
+    inline void reset()
+    {
+        auto& global = Details::registry();
+
+        std::lock_guard lk{global.mtx};
+        global.sites.clear();
+    }
+}
+
+#endif
@@ -0,0 +1,181 @@
+#ifndef UNITS_HPP
+#define UNITS_HPP
+
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// dimensional analysis resolved at compile time
+// - a quantity is a single double in SI base units (m, s, kg) - a dimension is only a type
+// - conversion factors are applied in constexpr literal operators, e.g. 2.0_h == 7200.0_s
+// - quantity<D> is trivially copyable and has the size of double, so arithmetic on quantities
+//   compiles to the same code as arithmetic on raw doubles
+
+namespace Units
+{
+    template <int Length, int Time, int Mass = 0>
+    struct dimension
+    {
+        static constexpr int length = Length;
+        static constexpr int time = Time;
+        static constexpr int mass = Mass;
+    };
+
+    template <typename D1, typename D2>
+    using dimension_multiply_t = dimension<D1::length + D2::length, D1::time + D2::time, D1::mass + D2::mass>;
+
+    template <typename D1, typename D2>
+    using dimension_divide_t = dimension<D1::length - D2::length, D1::time - D2::time, D1::mass - D2::mass>;
+
+    using dimensionless = dimension<0, 0, 0>;
+
+    template <typename TDimension>
+    class quantity
+    {
+        double value_{};
+
+    public:
+        using dimension_type = TDimension;
+
+        constexpr quantity() = default;
+
+        constexpr explicit quantity(double value_in_si_units)
+            : value_{value_in_si_units}
+        {
+        }
+
+        // value in SI base units
+        constexpr double value() const
+        {
+            return value_;
+        }
+
+        // value expressed in other unit of the same dimension, e.g. speed.in(1.0_km / 1.0_h)
+        constexpr double in(quantity unit) const
+        {
+            return value_ / unit.value_;
+        }
+
+        constexpr quantity& operator+=(quantity other)
+        {
+            value_ += other.value_;
+            return *this;
+        }
+
+        constexpr quantity& operator-=(quantity other)
+        {
+            value_ -= other.value_;
+            return *this;
+        }
+
+        constexpr quantity operator-() const
+        {
+            return quantity{-value_};
+        }
+
+        friend constexpr quantity operator+(quantity a, quantity b)
+        {
+            return quantity{a.value_ + b.value_};
+        }
+
+        friend constexpr quantity operator-(quantity a, quantity b)
+        {
+            return quantity{a.value_ - b.value_};
+        }
+
+        friend constexpr quantity operator*(double factor, quantity q)
+        {
+            return quantity{factor * q.value_};
+        }
+
+        friend constexpr quantity operator*(quantity q, double factor)
+        {
+            return quantity{q.value_ * factor};
+        }
+
+        friend constexpr quantity operator/(quantity q, double factor)
+        {
+            return quantity{q.value_ / factor};
+        }
+
+        constexpr auto operator<=>(const quantity&) const = default;
+    };
+
+    template <typename D1, typename D2>
+    constexpr auto operator*(quantity<D1> a, quantity<D2> b)
+    {
+        return quantity<dimension_multiply_t<D1, D2>>{a.value() * b.value()};
+    }
+
+    template <typename D1, typename D2>
+    constexpr auto operator/(quantity<D1> a, quantity<D2> b)
+    {
+        return quantity<dimension_divide_t<D1, D2>>{a.value() / b.value()};
+    }
+
+    using Length = quantity<dimension<1, 0>>;
+    using Time = quantity<dimension<0, 1>>;
+    using Mass = quantity<dimension<0, 0, 1>>;
+    using Speed = quantity<dimension<1, -1>>;
+    using Acceleration = quantity<dimension<1, -2>>;
+
+    static_assert(sizeof(Speed) == sizeof(double));
+    static_assert(std::is_trivially_copyable_v<Speed>);
+
+    ////////////////////////////////////////////////////////////////////
+    // batch kernels - plain loops over contiguous doubles, vectorized by an optimizer
+
+    template <typename TDistance, typename TTime>
+    void divide(std::span<const quantity<TDistance>> numerators, std::span<const quantity<TTime>> denominators,
+        std::span<quantity<dimension_divide_t<TDistance, TTime>>> results)
+    {
+        assert(numerators.size() == denominators.size() && numerators.size() == results.size());
+
+        for (size_t i = 0; i < results.size(); ++i)
+            results[i] = numerators[i] / denominators[i];
+    }
+
+    template <typename TDimension>
+    quantity<TDimension> sum(std::span<const quantity<TDimension>> values)
+    {
+        quantity<TDimension> total{};
+
+        for (const auto& value : values)
+            total += value;
+
+        return total;
+    }
+
+    namespace Literals
+    {
+        // length
+        constexpr Length operator""_m(long double value) { return Length{static_cast<double>(value)}; }
+        constexpr Length operator""_m(unsigned long long value) { return Length{static_cast<double>(value)}; }
+        constexpr Length operator""_km(long double value) { return Length{static_cast<double>(value) * 1000.0}; }
+        constexpr Length operator""_km(unsigned long long value) { return Length{static_cast<double>(value) * 1000.0}; }
+
+        // time
+        constexpr Time operator""_s(long double value) { return Time{static_cast<double>(value)}; }
+        constexpr Time operator""_s(unsigned long long value) { return Time{static_cast<double>(value)}; }
+        constexpr Time operator""_min(long double value) { return Time{static_cast<double>(value) * 60.0}; }
+        constexpr Time operator""_min(unsigned long long value) { return Time{static_cast<double>(value) * 60.0}; }
+        constexpr Time operator""_h(long double value) { return Time{static_cast<double>(value) * 3600.0}; }
+        constexpr Time operator""_h(unsigned long long value) { return Time{static_cast<double>(value) * 3600.0}; }
+
+        // mass
+        constexpr Mass operator""_kg(long double value) { return Mass{static_cast<double>(value)}; }
+        constexpr Mass operator""_kg(unsigned long long value) { return Mass{static_cast<double>(value)}; }
+        constexpr Mass operator""_g(long double value) { return Mass{static_cast<double>(value) / 1000.0}; }
+        constexpr Mass operator""_g(unsigned long long value) { return Mass{static_cast<double>(value) / 1000.0}; }
+
+        // speed
+        constexpr Speed operator""_mps(long double value) { return Speed{static_cast<double>(value)}; }
+        constexpr Speed operator""_kmph(long double value) { return Speed{static_cast<double>(value) / 3.6}; }
+        constexpr Speed operator""_kmph(unsigned long long value) { return Speed{static_cast<double>(value) / 3.6}; }
+    }
+}
+
+#endif
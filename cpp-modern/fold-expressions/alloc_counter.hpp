@@ -0,0 +1,25 @@
+#ifndef ALLOC_COUNTER_HPP
+#define ALLOC_COUNTER_HPP
+
+#include <cstddef>
+
+// number of calls to global operator new since program start
+size_t total_allocations();
+
+class AllocationCounter
+{
+    size_t start_;
+
+public:
+    AllocationCounter()
+        : start_{total_allocations()}
+    {
+    }
+
+    size_t count() const
+    {
+        return total_allocations() - start_;
+    }
+};
+
+#endif
@@ -0,0 +1,296 @@
+#ifndef ASYNC_PRINT_HPP
+#define ASYNC_PRINT_HPP
+
+#include <atomic>
+#include <charconv>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// variadic print that never blocks a caller on a stream
+// - a line is formatted in a thread local buffer (std::to_chars for numbers) - the same text as operator<<
+//   with default flags: floating point as %g with precision 6, character types as characters
+// - complete lines are pushed to a lock-free MPSC queue
+// - a background thread drains the queue and writes lines in batches
+
+namespace AsyncPrint
+{
+    // intrusive multi-producer single-consumer queue (D. Vyukov)
+    // - push is wait-free: one exchange + one store
+    // - pop may see an empty queue for a moment when a producer is between exchange and store
+    class LineQueue
+    {
+    public:
+        struct Node
+        {
+            std::atomic<Node*> next{nullptr};
+            std::string line;
+            std::shared_ptr<std::atomic<bool>> flushed; // flush marker - set by a writer when all previous lines are written
+                                                        // shared - a waiting caller may return as soon as the flag is set
+        };
+
+    private:
+        Node stub_;
+        std::atomic<Node*> head_{&stub_}; // producers
+        Node* tail_{&stub_};              // consumer
+
+        void push_node(Node* node) noexcept
+        {
+            node->next.store(nullptr, std::memory_order_relaxed);
+            Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+            prev->next.store(node, std::memory_order_release);
+        }
+
+    public:
+        LineQueue() = default;
+        LineQueue(const LineQueue&) = delete;
+        LineQueue& operator=(const LineQueue&) = delete;
+
+        ~LineQueue()
+        {
+            while (pop())
+                ;
+        }
+
+        void push(std::unique_ptr<Node> node) noexcept
+        {
+            push_node(node.release());
+        }
+
+        std::unique_ptr<Node> pop() noexcept
+        {
+            Node* tail = tail_;
+            Node* next = tail->next.load(std::memory_order_acquire);
+
+            if (tail == &stub_)
+            {
+                if (next == nullptr)
+                    return nullptr;
+
+                tail_ = tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+
+            if (next)
+            {
+                tail_ = next;
+                return std::unique_ptr<Node>(tail);
+            }
+
+            if (tail != head_.load(std::memory_order_acquire))
+                return nullptr; // producer in progress
+
+            push_node(&stub_);
+
+            next = tail->next.load(std::memory_order_acquire);
+            if (next)
+            {
+                tail_ = next;
+                return std::unique_ptr<Node>(tail);
+            }
+
+            return nullptr;
+        }
+    };
+
+    class LineWriter
+    {
+        LineQueue queue_;
+        std::ostream& out_;
+        std::atomic<size_t> signal_{0};
+        std::atomic<bool> is_done_{false};
+        std::jthread writer_;
+
+        void run()
+        {
+            std::string batch;
+
+            auto write_batch = [&] {
+                out_.write(batch.data(), batch.size());
+                out_.flush();
+                batch.clear();
+            };
+
+            while (true)
+            {
+                const size_t seen_signal = signal_.load(std::memory_order_acquire);
+                const bool is_done = is_done_.load(std::memory_order_acquire);
+
+                bool is_empty = true;
+                while (auto node = queue_.pop())
+                {
+                    is_empty = false;
+
+                    if (node->flushed)
+                    {
+                        write_batch();
+                        node->flushed->store(true, std::memory_order_release);
+                        node->flushed->notify_one();
+                    }
+                    else
+                        batch += node->line;
+                }
+
+                if (!batch.empty())
+                    write_batch();
+
+                if (!is_empty)
+                    continue;
+
+                if (is_done)
+                    return;
+
+                signal_.wait(seen_signal, std::memory_order_acquire);
+            }
+        }
+
+        void push_node(std::unique_ptr<LineQueue::Node> node)
+        {
+            queue_.push(std::move(node));
+
+            signal_.fetch_add(1, std::memory_order_release);
+            signal_.notify_one();
+        }
+
+    public:
+        explicit LineWriter(std::ostream& out)
+            : out_{out}
+            , writer_{[this] { run(); }}
+        {
+        }
+
+        LineWriter(const LineWriter&) = delete;
+        LineWriter& operator=(const LineWriter&) = delete;
+
+        ~LineWriter()
+        {
+            is_done_.store(true, std::memory_order_release);
+            signal_.fetch_add(1, std::memory_order_release);
+            signal_.notify_one();
+            writer_.join(); // all pushed lines are written before join returns
+        }
+
+        void push(std::string_view line)
+        {
+            auto node = std::make_unique<LineQueue::Node>();
+            node->line = line;
+            push_node(std::move(node));
+        }
+
+        // blocks until all lines pushed before the call are written
+        void flush()
+        {
+            auto flushed = std::make_shared<std::atomic<bool>>(false);
+
+            auto marker = std::make_unique<LineQueue::Node>();
+            marker->flushed = flushed;
+            push_node(std::move(marker));
+
+            flushed->wait(false, std::memory_order_acquire);
+        }
+    };
+
+    inline LineWriter& default_writer()
+    {
+        static LineWriter writer{std::cout};
+        return writer;
+    }
+
+    namespace Details
+    {
+        template <typename T>
+        constexpr bool is_character_v = std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>;
+
+        template <typename T>
+        void format_to(std::string& buffer, const T& arg)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                char digits[64];
+                auto [end, error_code] = std::to_chars(std::begin(digits), std::end(digits), arg, std::chars_format::general, 6);
+                buffer.append(digits, end);
+            }
+            else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool> && !is_character_v<T>)
+            {
+                char digits[64];
+                auto [end, error_code] = std::to_chars(std::begin(digits), std::end(digits), arg);
+                buffer.append(digits, end);
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+            {
+                buffer += arg ? '1' : '0'; // the same as std::cout without std::boolalpha
+            }
+            else if constexpr (is_character_v<T>)
+            {
+                buffer += static_cast<char>(arg);
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            {
+                buffer += arg;
+            }
+            else
+            {
+                thread_local std::ostringstream out;
+                out.str({});
+                out << arg;
+                buffer += out.view();
+            }
+        }
+
+        inline std::string& line_buffer()
+        {
+            thread_local std::string buffer;
+            buffer.clear();
+            return buffer;
+        }
+    }
+
+    template <typename... TArgs>
+    void print_to(LineWriter& writer, const TArgs&... args)
+    {
+        std::string& line = Details::line_buffer();
+
+        auto with_space = [&line, is_first = true](const auto& item) mutable {
+            if (!is_first)
+                line += ' ';
+            is_first = false;
+            Details::format_to(line, item);
+        };
+
+        (..., with_space(args));
+        line += '\n';
+
+        writer.push(line);
+    }
+
+    // all lines are pushed as one item - they are never interleaved with output of other threads
+    template <typename... TArgs>
+    void print_lines_to(LineWriter& writer, const TArgs&... args)
+    {
+        std::string& lines = Details::line_buffer();
+
+        (..., (Details::format_to(lines, args), lines += '\n'));
+
+        writer.push(lines);
+    }
+
+    template <typename... TArgs>
+    void print(const TArgs&... args)
+    {
+        print_to(default_writer(), args...);
+    }
+
+    template <typename... TArgs>
+    void print_lines(const TArgs&... args)
+    {
+        print_lines_to(default_writer(), args...);
+    }
+}
+
+#endif
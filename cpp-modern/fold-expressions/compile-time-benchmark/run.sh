@@ -0,0 +1,142 @@
+#!/usr/bin/env bash
+#
+# Compile-time benchmark of variadic recursion vs. fold expressions & index_sequence
+#
+# For every variant and pack size N a translation unit calling it with N arguments is generated
+# and compiled at -O0. Reported columns:
+#   - instantiations - function template instantiations emitted to the object file (nm)
+#   - time [s]       - wall time of the compilation
+#
+# Usage: ./run.sh [N...]            (default: 10 50 100 200 500 1000)
+#        CXX=clang++ ./run.sh 100 1000
+
+set -euo pipefail
+
+CXX=${CXX:-c++}
+SIZES=("${@:-10 50 100 200 500 1000}")
+SIZES=(${SIZES[@]})
+SCRIPT_DIR=$(cd "$(dirname "$0")" && pwd)
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+VARIANTS=(recursive_sum constexpr_if_sum fold_sum recursive_print fold_print recursive_type_at type_at)
+
+definitions()
+{
+    case $1 in
+    recursive_sum) cat <<'CPP'
+template <typename T>
+auto sum(const T& last) { return last; }
+
+template <typename THead, typename... TTail>
+auto sum(const THead& head, const TTail&... tail) { return head + sum(tail...); }
+CPP
+    ;;
+    constexpr_if_sum) cat <<'CPP'
+template <typename THead, typename... TTail>
+auto sum(const THead& head, const TTail&... tail)
+{
+    if constexpr (sizeof...(tail) > 0)
+        return head + sum(tail...);
+    else
+        return head;
+}
+CPP
+    ;;
+    fold_sum) cat <<'CPP'
+template <typename... TArgs>
+auto sum(const TArgs&... args) { return (... + args); }
+CPP
+    ;;
+    recursive_print) cat <<'CPP'
+#include <iostream>
+
+template <typename THead, typename... TTail>
+void print(const THead& head, const TTail&... tail)
+{
+    std::cout << head << " ";
+
+    if constexpr (sizeof...(tail) > 0)
+        print(tail...);
+    else
+        std::cout << "\n";
+}
+CPP
+    ;;
+    fold_print) cat <<'CPP'
+#include <iostream>
+
+template <typename... TArgs>
+void print(const TArgs&... args)
+{
+    (..., (std::cout << args << " "));
+    std::cout << "\n";
+}
+CPP
+    ;;
+    recursive_type_at) cat <<'CPP'
+#include <cstddef>
+
+template <size_t I, typename THead, typename... TTail>
+struct TypeAt : TypeAt<I - 1, TTail...> {};
+
+template <typename THead, typename... TTail>
+struct TypeAt<0, THead, TTail...> { using type = THead; };
+
+template <size_t I, typename... Ts>
+using TypeAt_t = typename TypeAt<I, Ts...>::type;
+CPP
+    ;;
+    type_at) cat <<CPP
+#include "$SCRIPT_DIR/../variadic.hpp"
+
+using Variadic::TypeAt_t;
+CPP
+    ;;
+    esac
+}
+
+# comma separated list: 1, 2, ..., N (or int, int, ... for types)
+pack()
+{
+    local n=$1 item=$2 result=""
+    for ((i = 1; i <= n; ++i)); do
+        result+="${item//@/$i}"
+        ((i < n)) && result+=", "
+    done
+    echo "$result"
+}
+
+usage()
+{
+    case $1 in
+    *_sum) echo "int main() { return static_cast<int>(sum($(pack "$2" '@LL')) % 2); }" ;;
+    *_print) echo "int main() { print($(pack "$2" '@')); }" ;;
+    *type_at) echo "template <int> struct Tag {};
+using Last = TypeAt_t<$(($2 - 1)), $(pack "$2" 'Tag<@>')>;
+static_assert(sizeof(Last) == 1);
+int main() {}" ;;
+    esac
+}
+
+printf "%-18s %6s %15s %10s\n" "variant" "N" "instantiations" "time [s]"
+
+for variant in "${VARIANTS[@]}"; do
+    for n in "${SIZES[@]}"; do
+        src="$WORK_DIR/${variant}_$n.cpp"
+        obj="$WORK_DIR/${variant}_$n.o"
+        { definitions "$variant"; usage "$variant" "$n"; } > "$src"
+
+        start=$(date +%s.%N)
+        if "$CXX" -std=c++20 -O0 -ftemplate-depth=2048 -c "$src" -o "$obj" 2> "$WORK_DIR/errors.txt"; then
+            end=$(date +%s.%N)
+            case $variant in
+            *type_at) instantiations="-" ;; # class templates leave no symbols
+            *) instantiations=$(nm -C "$obj" | grep -cE " (sum|print)<" || true) ;;
+            esac
+            printf "%-18s %6d %15s %10.3f\n" "$variant" "$n" "$instantiations" "$(awk "BEGIN { print $end - $start }")"
+        else
+            printf "%-18s %6d %15s %10s\n" "$variant" "$n" "-" "failed"
+        fi
+    done
+done
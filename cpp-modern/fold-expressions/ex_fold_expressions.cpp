@@ -1,4 +1,5 @@
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <set>
 #include <string>
@@ -6,6 +7,13 @@
 #include <vector>
 #include <algorithm>
 #include <numeric>
+#include <span>
+
+#include "alloc_counter.hpp"
+#include "poly_vector.hpp"
+#include "range_check.hpp"
+#include "small_vector.hpp"
+#include "static_vector.hpp"
 
 #include "catch.hpp"
 
@@ -119,6 +127,230 @@ TEST_CASE("make_vector - create vector from a list of arguments")
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+template <typename... TArgs>
+auto make_small_vector(TArgs&&... args)
+{
+    static_assert(sizeof...(args) > 0, "make_small_vector needs at least one param");
+
+    using TValue = std::common_type_t<TArgs...>;
+
+    small_vector<TValue, sizeof...(args)> v;
+
+    (..., v.push_back(std::forward<TArgs>(args)));
+    return v;
+}
+
+template <typename... TArgs>
+auto make_static_vector(TArgs&&... args)
+{
+    static_assert(sizeof...(args) > 0, "make_static_vector needs at least one param");
+
+    using TValue = std::common_type_t<TArgs...>;
+
+    static_vector<TValue, sizeof...(args)> v;
+
+    (..., v.push_back(std::forward<TArgs>(args)));
+    return v;
+}
+
+TEST_CASE("make_small_vector - inline storage for sizeof...(args) items")
+{
+    SECTION("ints")
+    {
+        AllocationCounter counter;
+
+        auto v = make_small_vector(1, 2, 3);
+
+        const auto allocations = counter.count();
+        REQUIRE(allocations == 0);
+
+        static_assert(is_same_v<decltype(v), small_vector<int, 3>>);
+        REQUIRE(v == small_vector<int, 3>{1, 2, 3});
+        REQUIRE(v.is_inline());
+    }
+
+    SECTION("unique_ptrs with polymorphic hierarchy")
+    {
+        auto g1 = make_unique<Gadget>();
+        auto g2 = make_unique<SuperGadget>();
+        auto g3 = make_unique<Gadget>();
+
+        AllocationCounter counter;
+
+        auto gadgets = make_small_vector(std::move(g1), std::move(g2), std::move(g3));
+
+        const auto allocations = counter.count();
+        REQUIRE(allocations == 0);
+
+        static_assert(is_same_v<decltype(gadgets)::value_type, unique_ptr<Gadget>>);
+
+        vector<string> ids;
+        transform(begin(gadgets), end(gadgets), back_inserter(ids), [](auto& ptr) { return ptr->id(); });
+
+        REQUIRE_THAT(ids, Catch::Matchers::Equals(vector<string>{"a", "b", "a"}));
+    }
+
+    SECTION("make_small_vector with lvalue")
+    {
+        std::string str = "text";
+        auto abc = "abc"s;
+
+        AllocationCounter counter;
+
+        auto words = make_small_vector(str, str, str, std::move(abc));
+
+        const auto allocations = counter.count();
+        REQUIRE(allocations == 0);
+
+        REQUIRE(str == "text");
+        REQUIRE(words == small_vector<string, 4>{"text"s, "text"s, "text"s, "abc"s});
+    }
+
+    SECTION("spills to the heap on growth")
+    {
+        auto v = make_small_vector(1, 2, 3);
+
+        AllocationCounter counter;
+
+        v.push_back(4);
+
+        const auto allocations = counter.count();
+        REQUIRE(allocations == 1);
+
+        REQUIRE(v.is_inline() == false);
+        REQUIRE(v.capacity() == 6);
+        REQUIRE(v == small_vector<int, 3>{1, 2, 3, 4});
+
+        auto moved = std::move(v);
+        REQUIRE(moved == small_vector<int, 3>{1, 2, 3, 4});
+        REQUIRE(v.empty());
+        REQUIRE(v.is_inline());
+    }
+}
+
+TEST_CASE("make_static_vector - never allocates")
+{
+    SECTION("unique_ptrs with polymorphic hierarchy")
+    {
+        auto g1 = make_unique<Gadget>();
+        auto g2 = make_unique<SuperGadget>();
+
+        AllocationCounter counter;
+
+        auto gadgets = make_static_vector(std::move(g1), std::move(g2));
+        auto moved_gadgets = std::move(gadgets);
+
+        const auto allocations = counter.count();
+        REQUIRE(allocations == 0);
+
+        static_assert(is_same_v<decltype(gadgets), static_vector<unique_ptr<Gadget>, 2>>);
+        REQUIRE(moved_gadgets[0]->id() == "a");
+        REQUIRE(moved_gadgets[1]->id() == "b");
+    }
+
+    SECTION("make_static_vector with lvalue")
+    {
+        std::string str = "text";
+
+        AllocationCounter counter;
+
+        auto words = make_static_vector(str, str, str, "abc"s);
+
+        const auto allocations = counter.count();
+        REQUIRE(allocations == 0);
+
+        REQUIRE(str == "text");
+        REQUIRE(words == static_vector<string, 4>{"text"s, "text"s, "text"s, "abc"s});
+    }
+
+    SECTION("throws when capacity is exceeded")
+    {
+        auto v = make_static_vector(1, 2);
+
+        REQUIRE_THROWS_AS(v.push_back(3), std::length_error);
+        REQUIRE(v.size() == 2);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T, typename... TArgs>
+constexpr size_t count_of_v = (0u + ... + std::is_same_v<T, std::remove_cvref_t<TArgs>>);
+
+template <typename... Ts, typename... TArgs>
+auto make_poly_vector(TArgs&&... args)
+{
+    poly_vector<Ts...> v;
+
+    (..., v.template reserve<Ts>(count_of_v<Ts, TArgs...>));
+    (..., v.push_back(std::forward<TArgs>(args)));
+
+    return v;
+}
+
+template <typename TContainer, typename T>
+concept can_push_back = requires(TContainer& container, T&& item) { container.push_back(std::forward<T>(item)); };
+
+TEST_CASE("poly_vector - objects of a polymorphic hierarchy stored by value")
+{
+    auto gadgets = make_poly_vector<Gadget, SuperGadget>(Gadget{}, SuperGadget{}, Gadget{});
+
+    REQUIRE(gadgets.size() == 3);
+    REQUIRE(gadgets.segment<Gadget>().size() == 2);
+    REQUIRE(gadgets.segment<SuperGadget>().size() == 1);
+
+    SECTION("for_each calls a visitor with a static type of an item")
+    {
+        vector<string> ids;
+
+        gadgets.for_each([&ids](const auto& g) {
+            using TGadget = std::remove_cvref_t<decltype(g)>;
+            ids.push_back(g.TGadget::id()); // qualified call - no virtual dispatch
+        });
+
+        REQUIRE_THAT(ids, Catch::Matchers::Equals(vector<string>{"a", "a", "b"}));
+    }
+
+    SECTION("segments are contiguous")
+    {
+        gadgets.reserve<SuperGadget>(1001); // no reallocation - addresses of stored objects stay valid
+
+        vector<const SuperGadget*> addresses;
+        gadgets.for_each([&addresses](const auto& g) {
+            if constexpr (std::is_same_v<std::remove_cvref_t<decltype(g)>, SuperGadget>)
+                addresses.push_back(&g);
+        });
+        for (int i = 0; i < 1000; ++i)
+            addresses.push_back(&gadgets.emplace<SuperGadget>());
+
+        REQUIRE(gadgets.segment<SuperGadget>().size() == 1001);
+        REQUIRE(addresses.front() == gadgets.segment<SuperGadget>().data());
+        for (size_t i = 1; i < addresses.size(); ++i)
+            REQUIRE(addresses[i] == addresses[i - 1] + 1);
+    }
+
+    SECTION("a reference to a polymorphic base may refer to a derived object - push_back doesn't slice it")
+    {
+        SuperGadget super_gadget;
+        Gadget& gadget = super_gadget;
+
+        static_assert(!can_push_back<decltype(gadgets), Gadget&>);
+        static_assert(can_push_back<decltype(gadgets), Gadget>);
+
+        gadgets.emplace<Gadget>(gadget); // slicing is explicit
+        REQUIRE(gadgets.segment<Gadget>().size() == 3);
+    }
+
+    SECTION("clear")
+    {
+        gadgets.clear();
+
+        REQUIRE(gadgets.empty());
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 template <typename T>
 struct range
 {
@@ -151,4 +383,86 @@ TEST_CASE("within - checks if all values fit in range [low, high]")
     REQUIRE(within(range{10, 20.0}, 1, 15, 30) == false);  
     REQUIRE(within(range{10, 20}, 11, 12, 13) == true);
     REQUIRE(within(range{5.0, 5.5}, 5.1, 5.2, 5.3) == true);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// within for large arrays
+
+constexpr size_t parallel_within_threshold = 1 << 20;
+
+// returns index of the first item outside the range or values.size() if all items fit
+template <typename T, typename U, size_t Extent>
+size_t find_outside(const range<T>& input, std::span<U, Extent> values)
+{
+    using TBound = std::common_type_t<T, std::remove_cv_t<U>>;
+
+    return RangeCheck::find_outside(values.data(), 0, values.size(),
+        static_cast<TBound>(input.low), static_cast<TBound>(input.high));
+}
+
+template <typename T, typename U, size_t Extent>
+size_t find_outside_parallel(const range<T>& input, std::span<U, Extent> values, size_t threshold = parallel_within_threshold)
+{
+    if (values.size() < threshold)
+        return find_outside(input, values);
+
+    using TBound = std::common_type_t<T, std::remove_cv_t<U>>;
+
+    return RangeCheck::find_outside_parallel(values.data(), values.size(),
+        static_cast<TBound>(input.low), static_cast<TBound>(input.high));
+}
+
+template <typename T, typename U, size_t Extent>
+bool within(const range<T>& input, std::span<U, Extent> values)
+{
+    return find_outside_parallel(input, values) == values.size();
+}
+
+TEST_CASE("within - checks if all values of an array fit in range [low, high]")
+{
+    std::vector<int> data(1000);
+    std::iota(data.begin(), data.end(), 0);
+
+    REQUIRE(within(range{0, 999}, std::span{data}) == true);
+    REQUIRE(within(range{0, 998}, std::span{data}) == false);
+    REQUIRE(within(range{0.5, 1000.0}, std::span{data}) == false);
+
+    SECTION("find_outside returns index of the first violation")
+    {
+        REQUIRE(find_outside(range{0, 999}, std::span{data}) == data.size());
+        REQUIRE(find_outside(range{1, 999}, std::span{data}) == 0);
+        REQUIRE(find_outside(range{0, 998}, std::span{data}) == 999);
+
+        data[130] = -1;
+        data[131] = 5000;
+        REQUIRE(find_outside(range{0, 999}, std::span{data}) == 130);
+        REQUIRE(find_outside(range{-1, 999}, std::span{data}) == 131);
+        REQUIRE(find_outside(range{0.0, 999.0}, std::span<const int>{data}) == 130);
+    }
+
+    SECTION("doubles")
+    {
+        std::vector<double> values(333, 5.2);
+        values[250] = 5.6;
+
+        REQUIRE(find_outside(range{5.0, 5.5}, std::span{values}) == 250);
+
+        values[7] = std::numeric_limits<double>::quiet_NaN();
+        REQUIRE(find_outside(range{5.0, 5.5}, std::span{values}) == 7);
+    }
+
+    SECTION("multi-threaded version")
+    {
+        std::vector<double> values(100'000, 0.5);
+
+        REQUIRE(find_outside_parallel(range{0.0, 1.0}, std::span{values}, 0) == values.size());
+
+        values[99'999] = 2.0;
+        values[70'001] = -1.0;
+        values[70'000] = 1.5;
+        REQUIRE(find_outside_parallel(range{0.0, 1.0}, std::span{values}, 0) == 70'000);
+
+        values[3] = 1.5;
+        REQUIRE(find_outside_parallel(range{0.0, 1.0}, std::span{values}, 0) == 3);
+    }
 }
\ No newline at end of file
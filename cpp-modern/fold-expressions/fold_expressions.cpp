@@ -1,11 +1,18 @@
+#include "async_print.hpp"
 #include "catch.hpp"
+#include "thread_pool.hpp"
+#include "variadic.hpp"
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
 #include <list>
 #include <map>
 #include <numeric>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -126,6 +133,17 @@ TEST_CASE("Head")
     static_assert(std::is_same_v<Head<int, double>::type, int>);
 }
 
+TEST_CASE("TypeAt - non-recursive access to a type in a pack")
+{
+    using namespace Variadic;
+
+    static_assert(std::is_same_v<Head_t<int, double>, Head<int, double>::type>);
+    static_assert(std::is_same_v<TypeAt_t<1, int, double, const char*>, double>);
+    static_assert(std::is_same_v<TypeAt_t<2, int, double, const char*>, const char*>);
+    static_assert(std::is_same_v<Last_t<int, double, std::string&>, std::string&>);
+    static_assert(std::is_same_v<TypeAt_t<1, int, int, int>, int>);
+}
+
 template <typename F, typename... TArgs>
 auto create_filled_vector(F f, TArgs&&... args)
 {
@@ -156,4 +174,229 @@ TEST_CASE("Before C++17")
     REQUIRE(squares == std::vector{1, 4, 9, 16, 25});
 
     static_assert(std::is_same_v<std::common_type_t<int, long, short>, long>);
-}
\ No newline at end of file
+}
+
+namespace Parallel
+{
+    namespace Details
+    {
+        // pairs of neighbours are combined as tasks - op must be associative, but not necessary commutative
+        template <typename TOp, typename T>
+        T tree_reduce(TOp& op, std::vector<T> level, ThreadPool& pool)
+        {
+            while (level.size() > 1)
+            {
+                std::vector<std::future<T>> pairs;
+                pairs.reserve(level.size() / 2);
+
+                for (size_t i = 0; i + 1 < level.size(); i += 2)
+                    pairs.push_back(pool.submit([&op, &level, i]() -> T { return op(std::move(level[i]), std::move(level[i + 1])); }));
+
+                for (auto& pair : pairs) // all tasks must finish before items of level are released
+                    pool.wait(pair);
+
+                std::vector<T> next_level;
+                next_level.reserve((level.size() + 1) / 2);
+
+                for (auto& pair : pairs)
+                    next_level.push_back(pair.get());
+
+                if (level.size() % 2 == 1)
+                    next_level.push_back(std::move(level.back()));
+
+                level = std::move(next_level);
+            }
+
+            return std::move(level.front());
+        }
+    }
+
+    // f is called concurrently for each of args - f & op may call parallel_apply/parallel_fold again
+    // (a pool thread waiting for nested tasks runs queued tasks meanwhile)
+    template <typename F, typename... TArgs>
+    auto parallel_apply(F f, TArgs&&... args)
+    {
+        using TValue = std::common_type_t<decltype(f(args))...>;
+
+        ThreadPool& pool = default_thread_pool();
+
+        std::vector<std::future<TValue>> results;
+        results.reserve(sizeof...(args));
+
+        (..., results.push_back(pool.submit([&f, &args]() -> TValue { return f(std::forward<TArgs>(args)); })));
+
+        for (auto& result : results) // all tasks must finish before args go out of scope
+            pool.wait(result);
+
+        std::vector<TValue> vec;
+        vec.reserve(sizeof...(args));
+
+        for (auto& result : results)
+            vec.push_back(result.get());
+
+        return vec;
+    }
+
+    template <typename TOp, typename... TArgs>
+    auto parallel_fold(TOp op, TArgs&&... args)
+    {
+        static_assert(sizeof...(args) > 0, "parallel_fold needs at least one param");
+
+        using TValue = std::common_type_t<TArgs...>;
+
+        std::vector<TValue> leaves;
+        leaves.reserve(sizeof...(args));
+
+        (..., leaves.push_back(std::forward<TArgs>(args)));
+
+        return Details::tree_reduce(op, std::move(leaves), default_thread_pool());
+    }
+}
+
+TEST_CASE("parallel apply & fold")
+{
+    using namespace Parallel;
+
+    SECTION("parallel_apply works as create_filled_vector")
+    {
+        auto square = [](int x) { return x * x; };
+
+        auto squares = parallel_apply(square, 1, 2, 3, 4, 5);
+
+        REQUIRE(squares == create_filled_vector(square, 1, 2, 3, 4, 5));
+    }
+
+    SECTION("parallel_apply - result is a common type")
+    {
+        auto twice = [](auto x) { return x + x; };
+
+        auto result = parallel_apply(twice, 1, 2L, short{3});
+
+        static_assert(std::is_same_v<decltype(result), std::vector<long>>);
+        REQUIRE(result == std::vector{2L, 4L, 6L});
+    }
+
+    SECTION("parallel_apply runs f on pool threads")
+    {
+        const auto main_id = std::this_thread::get_id();
+
+        auto ids = parallel_apply([](int) { return std::this_thread::get_id(); }, 1, 2, 3);
+
+        REQUIRE(std::ranges::none_of(ids, [main_id](auto id) { return id == main_id; }));
+    }
+
+    SECTION("parallel_fold works as sum")
+    {
+        REQUIRE(parallel_fold(std::plus{}, 1, 2, 3, 4, 5) == SinceCpp17::sum(1, 2, 3, 4, 5));
+        REQUIRE(parallel_fold(std::plus{}, 42) == 42);
+
+        static_assert(std::is_same_v<decltype(parallel_fold(std::plus{}, 1, 2L, short{3})), long>);
+    }
+
+    SECTION("parallel_fold keeps an order of args")
+    {
+        using namespace std::literals;
+
+        auto text = parallel_fold(std::plus{}, "a"s, "b"s, "c"s, "d"s, "e"s, "f"s, "g"s);
+
+        REQUIRE(text == "abcdefg");
+    }
+
+    SECTION("nested calls don't block all threads of the pool")
+    {
+        auto sum_of_squares = [](int n) {
+            auto squares = parallel_apply([](int x) { return x * x; }, n, n + 1, n + 2);
+            return std::accumulate(squares.begin(), squares.end(), 0);
+        };
+
+        auto sums = parallel_apply(sum_of_squares, 1, 2, 3, 4, 5, 6, 7, 8);
+        REQUIRE(sums == create_filled_vector(sum_of_squares, 1, 2, 3, 4, 5, 6, 7, 8));
+
+        auto nested_plus = [](int a, int b) { return parallel_fold(std::plus{}, a, b); };
+        REQUIRE(parallel_fold(nested_plus, 1, 2, 3, 4, 5, 6, 7, 8) == 36);
+    }
+
+    SECTION("exceptions are propagated")
+    {
+        auto throwing = [](int x) {
+            if (x == 2)
+                throw std::runtime_error("error");
+            return x;
+        };
+
+        REQUIRE_THROWS_AS(parallel_apply(throwing, 1, 2, 3), std::runtime_error);
+    }
+}
+
+TEST_CASE("async print")
+{
+    std::ostringstream out;
+    AsyncPrint::LineWriter writer{out};
+
+    SECTION("formats a line as SinceCpp17::print")
+    {
+        AsyncPrint::print_to(writer, 1, 3.14, "text", std::string("str"), 'c', -42L, true);
+        writer.flush();
+
+        REQUIRE(out.str() == "1 3.14 text str c -42 1\n");
+    }
+
+    SECTION("numbers & characters are formatted as with operator<<")
+    {
+        const double third = 1.0 / 3;
+        const signed char letter = 'a';
+        const unsigned char other_letter = 'b';
+
+        AsyncPrint::print_to(writer, third, 1e20, 123456789.0, 0.0001, -2.5f, letter, other_letter, 255u);
+        writer.flush();
+
+        std::ostringstream expected;
+        expected << third << ' ' << 1e20 << ' ' << 123456789.0 << ' ' << 0.0001 << ' ' << -2.5f << ' '
+                 << letter << ' ' << other_letter << ' ' << 255u << '\n';
+
+        REQUIRE(out.str() == expected.str());
+        REQUIRE(out.str() == "0.333333 1e+20 1.23457e+08 0.0001 -2.5 a b 255\n");
+    }
+
+    SECTION("print_lines")
+    {
+        AsyncPrint::print_lines_to(writer, 1, 3.14, "text");
+        writer.flush();
+
+        REQUIRE(out.str() == "1\n3.14\ntext\n");
+    }
+
+    SECTION("lines from many threads are never interleaved")
+    {
+        constexpr int threads_count = 8;
+        constexpr int lines_count = 1000;
+
+        {
+            std::vector<std::jthread> threads;
+            for (int id = 0; id < threads_count; ++id)
+                threads.emplace_back([&writer, id] {
+                    for (int i = 0; i < lines_count; ++i)
+                        AsyncPrint::print_to(writer, "thread", id, "line", i);
+                });
+        }
+        writer.flush();
+
+        std::vector<int> next_line(threads_count, 0);
+        std::istringstream lines{out.str()};
+        int count = 0;
+
+        for (std::string line; std::getline(lines, line); ++count)
+        {
+            std::istringstream items{line};
+            std::string thread_label, line_label;
+            int id = -1, i = -1;
+
+            REQUIRE((items >> thread_label >> id >> line_label >> i));
+            REQUIRE(thread_label == "thread");
+            REQUIRE(line_label == "line");
+            REQUIRE(i == next_line.at(id)++); // order of lines from one thread is kept
+        }
+
+        REQUIRE(count == threads_count * lines_count);
+    }
+}
@@ -0,0 +1,106 @@
+#ifndef POLY_VECTOR_HPP
+#define POLY_VECTOR_HPP
+
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// container of objects from a closed set of types - each type is stored by value
+// in its own contiguous segment, so iteration has no pointer chasing and
+// visitors are called with the concrete (static) type of an object
+// - the static type of an item decides its segment - objects are never stored by a dynamic type
+
+template <typename... Ts>
+class poly_vector
+{
+    static_assert(sizeof...(Ts) > 0, "poly_vector needs at least one type");
+
+    std::tuple<std::vector<Ts>...> segments_;
+
+    template <typename T>
+    static constexpr bool is_stored_v = (... || std::is_same_v<T, Ts>);
+
+public:
+    template <typename T, typename... TArgs>
+    T& emplace(TArgs&&... args)
+    {
+        static_assert(is_stored_v<T>, "type is not stored in this poly_vector");
+
+        return std::get<std::vector<T>>(segments_).emplace_back(std::forward<TArgs>(args)...);
+    }
+
+    // an lvalue of a non-final polymorphic type may refer to a derived object, which would be sliced -
+    // it is rejected: emplace<T>(item) chooses the segment explicitly
+    template <typename T, typename TItem = std::remove_cvref_t<T>>
+        requires(!std::is_lvalue_reference_v<T> || !std::is_polymorphic_v<TItem> || std::is_final_v<TItem>)
+    void push_back(T&& item)
+    {
+        emplace<TItem>(std::forward<T>(item));
+    }
+
+    template <typename T>
+    std::span<T> segment()
+    {
+        static_assert(is_stored_v<T>, "type is not stored in this poly_vector");
+
+        return std::get<std::vector<T>>(segments_);
+    }
+
+    template <typename T>
+    std::span<const T> segment() const
+    {
+        static_assert(is_stored_v<T>, "type is not stored in this poly_vector");
+
+        return std::get<std::vector<T>>(segments_);
+    }
+
+    template <typename T>
+    void reserve(size_t count)
+    {
+        static_assert(is_stored_v<T>, "type is not stored in this poly_vector");
+
+        std::get<std::vector<T>>(segments_).reserve(count);
+    }
+
+    size_t size() const
+    {
+        return (0u + ... + std::get<std::vector<Ts>>(segments_).size());
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    void clear()
+    {
+        (..., std::get<std::vector<Ts>>(segments_).clear());
+    }
+
+    // visits segments in order of Ts... - f is instantiated separately for every type
+    template <typename F>
+    void for_each(F&& f)
+    {
+        (..., for_each_in(std::get<std::vector<Ts>>(segments_), f));
+    }
+
+    template <typename F>
+    void for_each(F&& f) const
+    {
+        (..., for_each_in(std::get<std::vector<Ts>>(segments_), f));
+    }
+
+private:
+    template <typename TSegment, typename F>
+    static void for_each_in(TSegment& segment, F& f)
+    {
+        for (auto& item : segment)
+            f(item);
+    }
+};
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef RANGE_CHECK_HPP
+#define RANGE_CHECK_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RANGE_CHECK_SSE2
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// kernels checking if items of an array fit in [low, high]
+// - items are tested in blocks and a block is scanned item by item only if it contains a violation
+// - NaN is never inside a range (the same as for low <= x && x <= high)
+
+namespace RangeCheck
+{
+    constexpr size_t block_size = 64;
+
+    template <typename T, typename TBound>
+    bool any_outside_scalar(const T* first, size_t count, TBound low, TBound high)
+    {
+        bool outside = false;
+
+        for (size_t i = 0; i < count; ++i) // branchless - vectorized by an optimizer
+            outside |= !(low <= first[i]) | !(first[i] <= high);
+
+        return outside;
+    }
+
+    template <typename T, typename TBound>
+    bool any_outside_block(const T* first, size_t count, TBound low, TBound high)
+    {
+        return any_outside_scalar(first, count, low, high);
+    }
+
+#ifdef RANGE_CHECK_SSE2
+    inline bool any_outside_block(const double* first, size_t count, double low, double high)
+    {
+        const __m128d lo = _mm_set1_pd(low);
+        const __m128d hi = _mm_set1_pd(high);
+        __m128d inside = _mm_cmpeq_pd(lo, lo);
+
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            const __m128d x = _mm_loadu_pd(first + i);
+            inside = _mm_and_pd(inside, _mm_and_pd(_mm_cmple_pd(lo, x), _mm_cmple_pd(x, hi)));
+        }
+
+        if (_mm_movemask_pd(inside) != 0b11)
+            return true;
+
+        return any_outside_scalar(first + i, count - i, low, high);
+    }
+
+    inline bool any_outside_block(const int* first, size_t count, int low, int high)
+    {
+        const __m128i lo = _mm_set1_epi32(low);
+        const __m128i hi = _mm_set1_epi32(high);
+        __m128i outside = _mm_setzero_si128();
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+            outside = _mm_or_si128(outside, _mm_or_si128(_mm_cmplt_epi32(x, lo), _mm_cmpgt_epi32(x, hi)));
+        }
+
+        if (_mm_movemask_epi8(outside) != 0)
+            return true;
+
+        return any_outside_scalar(first + i, count - i, low, high);
+    }
+#endif
+
+    // returns index of the first item outside [low, high] in [begin, end) or end if all items fit
+    template <typename T, typename TBound>
+    size_t find_outside(const T* data, size_t begin, size_t end, TBound low, TBound high)
+    {
+        for (size_t block_start = begin; block_start < end; block_start += block_size)
+        {
+            const size_t block_end = std::min(block_start + block_size, end);
+
+            if (any_outside_block(data + block_start, block_end - block_start, low, high))
+            {
+                for (size_t i = block_start; i < block_end; ++i)
+                    if (!(low <= data[i] && data[i] <= high))
+                        return i;
+            }
+        }
+
+        return end;
+    }
+
+    template <typename T, typename TBound>
+    size_t find_outside_parallel(const T* data, size_t count, TBound low, TBound high,
+        size_t thread_count = std::max(1u, std::thread::hardware_concurrency()))
+    {
+        std::atomic<size_t> first_outside{count};
+
+        const size_t blocks_count = (count + block_size - 1) / block_size;
+        const size_t chunk_size = (blocks_count + thread_count - 1) / thread_count * block_size;
+
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(thread_count);
+
+            for (size_t chunk_start = 0; chunk_start < count; chunk_start += chunk_size)
+            {
+                const size_t chunk_end = std::min(chunk_start + chunk_size, count);
+
+                workers.emplace_back([=, &first_outside] {
+                    for (size_t block_start = chunk_start; block_start < chunk_end; block_start += block_size)
+                    {
+                        // a violation with lower index has been already found by other thread
+                        if (first_outside.load(std::memory_order_relaxed) < block_start)
+                            return;
+
+                        const size_t block_end = std::min(block_start + block_size, chunk_end);
+
+                        if (const size_t pos = find_outside(data, block_start, block_end, low, high); pos != block_end)
+                        {
+                            size_t current = first_outside.load(std::memory_order_relaxed);
+                            while (pos < current && !first_outside.compare_exchange_weak(current, pos, std::memory_order_relaxed))
+                            {
+                            }
+                            return;
+                        }
+                    }
+                });
+            }
+        } // joins workers
+
+        return first_outside.load();
+    }
+}
+
+#endif
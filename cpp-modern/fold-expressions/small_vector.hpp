@@ -0,0 +1,262 @@
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace Details
+{
+    // moves when it can't throw (or when copying is impossible) - like std::move_if_noexcept
+    template <typename T>
+    void relocate(T* first, T* last, T* dest)
+    {
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+            std::uninitialized_move(first, last, dest);
+        else
+            std::uninitialized_copy(first, last, dest);
+
+        std::destroy(first, last);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// vector with inline storage for N items - spills to the heap when it grows above N
+
+template <typename T, size_t N>
+class small_vector
+{
+    static_assert(N > 0, "small_vector needs inline capacity of at least one item");
+
+    alignas(T) std::byte inline_buffer_[N * sizeof(T)];
+    T* data_;
+    size_t size_{};
+    size_t capacity_{N};
+
+    T* inline_data() noexcept
+    {
+        return std::launder(reinterpret_cast<T*>(inline_buffer_));
+    }
+
+    const T* inline_data() const noexcept
+    {
+        return std::launder(reinterpret_cast<const T*>(inline_buffer_));
+    }
+
+    void release_heap() noexcept
+    {
+        if (!is_inline())
+            std::allocator<T>{}.deallocate(data_, capacity_);
+    }
+
+    T* grow_to(size_t new_capacity)
+    {
+        T* new_data = std::allocator<T>{}.allocate(new_capacity);
+        try
+        {
+            Details::relocate(data_, data_ + size_, new_data);
+        }
+        catch (...)
+        {
+            std::allocator<T>{}.deallocate(new_data, new_capacity);
+            throw;
+        }
+
+        release_heap();
+        data_ = new_data;
+        capacity_ = new_capacity;
+
+        return data_;
+    }
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    small_vector() noexcept
+        : data_{inline_data()}
+    {
+    }
+
+    small_vector(std::initializer_list<T> items)
+        : small_vector()
+    {
+        reserve(items.size());
+        std::uninitialized_copy(items.begin(), items.end(), data_);
+        size_ = items.size();
+    }
+
+    small_vector(const small_vector& other)
+        : small_vector()
+    {
+        reserve(other.size_);
+        std::uninitialized_copy(other.begin(), other.end(), data_);
+        size_ = other.size_;
+    }
+
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : small_vector()
+    {
+        steal(other);
+    }
+
+    small_vector& operator=(const small_vector& other)
+    {
+        if (this != &other)
+        {
+            small_vector temp(other);
+            clear();
+            steal(temp);
+        }
+
+        return *this;
+    }
+
+    small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other)
+        {
+            clear();
+            steal(other);
+        }
+
+        return *this;
+    }
+
+    ~small_vector()
+    {
+        clear();
+        release_heap();
+    }
+
+    iterator begin() noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    static constexpr size_t inline_capacity() noexcept { return N; }
+
+    bool is_inline() const noexcept
+    {
+        return data_ == inline_data();
+    }
+
+    T& operator[](size_t index) { return data_[index]; }
+    const T& operator[](size_t index) const { return data_[index]; }
+
+    T& front() { return data_[0]; }
+    const T& front() const { return data_[0]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& back() const { return data_[size_ - 1]; }
+
+    void reserve(size_t new_capacity)
+    {
+        if (new_capacity > capacity_)
+            grow_to(new_capacity);
+    }
+
+    template <typename... TArgs>
+    T& emplace_back(TArgs&&... args)
+    {
+        if (size_ == capacity_)
+        {
+            // new item is constructed before relocation - args may refer to an item of this vector
+            const size_t new_capacity = 2 * capacity_;
+            T* new_data = std::allocator<T>{}.allocate(new_capacity);
+            try
+            {
+                std::construct_at(new_data + size_, std::forward<TArgs>(args)...);
+            }
+            catch (...)
+            {
+                std::allocator<T>{}.deallocate(new_data, new_capacity);
+                throw;
+            }
+
+            try
+            {
+                Details::relocate(data_, data_ + size_, new_data);
+            }
+            catch (...)
+            {
+                std::destroy_at(new_data + size_);
+                std::allocator<T>{}.deallocate(new_data, new_capacity);
+                throw;
+            }
+
+            release_heap();
+            data_ = new_data;
+            capacity_ = new_capacity;
+        }
+        else
+        {
+            std::construct_at(data_ + size_, std::forward<TArgs>(args)...);
+        }
+
+        return data_[size_++];
+    }
+
+    void push_back(const T& item)
+    {
+        emplace_back(item);
+    }
+
+    void push_back(T&& item)
+    {
+        emplace_back(std::move(item));
+    }
+
+    void pop_back()
+    {
+        std::destroy_at(data_ + --size_);
+    }
+
+    void clear() noexcept
+    {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    bool operator==(const small_vector& other) const
+    {
+        return std::equal(begin(), end(), other.begin(), other.end());
+    }
+
+private:
+    // precondition: this is empty
+    void steal(small_vector& other)
+    {
+        if (other.is_inline())
+        {
+            reserve(other.size_);
+            Details::relocate(other.data_, other.data_ + other.size_, data_);
+            size_ = other.size_;
+            other.size_ = 0;
+        }
+        else
+        {
+            release_heap();
+            data_ = std::exchange(other.data_, other.inline_data());
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, N);
+        }
+    }
+};
+
+#endif
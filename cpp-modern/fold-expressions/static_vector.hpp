@@ -0,0 +1,150 @@
+#ifndef STATIC_VECTOR_HPP
+#define STATIC_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// vector with fixed capacity N - never allocates, throws std::length_error when full
+
+template <typename T, size_t N>
+class static_vector
+{
+    alignas(T) std::byte buffer_[N * sizeof(T)];
+    size_t size_{};
+
+    T* items() noexcept
+    {
+        return std::launder(reinterpret_cast<T*>(buffer_));
+    }
+
+    const T* items() const noexcept
+    {
+        return std::launder(reinterpret_cast<const T*>(buffer_));
+    }
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static_vector() noexcept = default;
+
+    static_vector(std::initializer_list<T> items)
+    {
+        for (const auto& item : items)
+            push_back(item);
+    }
+
+    static_vector(const static_vector& other)
+    {
+        std::uninitialized_copy(other.begin(), other.end(), items());
+        size_ = other.size_;
+    }
+
+    static_vector(static_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        std::uninitialized_move(other.begin(), other.end(), items());
+        size_ = other.size_;
+        other.clear();
+    }
+
+    static_vector& operator=(const static_vector& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            std::uninitialized_copy(other.begin(), other.end(), items());
+            size_ = other.size_;
+        }
+
+        return *this;
+    }
+
+    static_vector& operator=(static_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other)
+        {
+            clear();
+            std::uninitialized_move(other.begin(), other.end(), items());
+            size_ = other.size_;
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    ~static_vector()
+    {
+        clear();
+    }
+
+    iterator begin() noexcept { return items(); }
+    iterator end() noexcept { return items() + size_; }
+    const_iterator begin() const noexcept { return items(); }
+    const_iterator end() const noexcept { return items() + size_; }
+
+    T* data() noexcept { return items(); }
+    const T* data() const noexcept { return items(); }
+
+    size_t size() const noexcept { return size_; }
+    static constexpr size_t capacity() noexcept { return N; }
+    bool empty() const noexcept { return size_ == 0; }
+    bool full() const noexcept { return size_ == N; }
+
+    T& operator[](size_t index) { return items()[index]; }
+    const T& operator[](size_t index) const { return items()[index]; }
+
+    T& front() { return items()[0]; }
+    const T& front() const { return items()[0]; }
+    T& back() { return items()[size_ - 1]; }
+    const T& back() const { return items()[size_ - 1]; }
+
+    template <typename... TArgs>
+    T& emplace_back(TArgs&&... args)
+    {
+        if (full())
+            throw std::length_error("static_vector capacity exceeded");
+
+        std::construct_at(items() + size_, std::forward<TArgs>(args)...);
+
+        return items()[size_++];
+    }
+
+    void push_back(const T& item)
+    {
+        emplace_back(item);
+    }
+
+    void push_back(T&& item)
+    {
+        emplace_back(std::move(item));
+    }
+
+    void pop_back()
+    {
+        std::destroy_at(items() + --size_);
+    }
+
+    void clear() noexcept
+    {
+        std::destroy(begin(), end());
+        size_ = 0;
+    }
+
+    bool operator==(const static_vector& other) const
+    {
+        return std::equal(begin(), end(), other.begin(), other.end());
+    }
+};
+
+#endif
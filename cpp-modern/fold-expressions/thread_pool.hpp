@@ -0,0 +1,143 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class ThreadPool
+{
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mtx_tasks_;
+    std::condition_variable cv_tasks_;
+    bool is_done_ = false;
+    std::vector<std::jthread> threads_;
+
+    static const ThreadPool*& this_thread_pool()
+    {
+        thread_local const ThreadPool* pool = nullptr;
+        return pool;
+    }
+
+    bool try_run_pending_task()
+    {
+        std::function<void()> task;
+
+        {
+            std::lock_guard lk{mtx_tasks_};
+            if (tasks_.empty())
+                return false;
+
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+
+        task();
+        return true;
+    }
+
+    void run()
+    {
+        this_thread_pool() = this;
+
+        while (true)
+        {
+            std::function<void()> task;
+
+            {
+                std::unique_lock lk{mtx_tasks_};
+                cv_tasks_.wait(lk, [this] { return is_done_ || !tasks_.empty(); });
+
+                if (tasks_.empty()) // is_done_ && no more work
+                    return;
+
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+
+            task();
+        }
+    }
+
+public:
+    explicit ThreadPool(size_t size = std::max(2u, std::thread::hardware_concurrency()))
+    {
+        threads_.reserve(size);
+        for (size_t i = 0; i < size; ++i)
+            threads_.emplace_back([this] { run(); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard lk{mtx_tasks_};
+            is_done_ = true;
+        }
+        cv_tasks_.notify_all();
+    } // jthreads join after all queued tasks are done
+
+    size_t size() const
+    {
+        return threads_.size();
+    }
+
+    template <typename F>
+    auto submit(F&& f)
+    {
+        using TResult = std::invoke_result_t<std::decay_t<F>&>;
+
+        // std::function requires copyable callables - packaged_task is move-only
+        auto task = std::make_shared<std::packaged_task<TResult()>>(std::forward<F>(f));
+        std::future<TResult> result = task->get_future();
+
+        {
+            std::lock_guard lk{mtx_tasks_};
+            tasks_.push([task] { (*task)(); });
+        }
+        cv_tasks_.notify_one();
+
+        return result;
+    }
+
+    bool is_pool_thread() const
+    {
+        return this_thread_pool() == this;
+    }
+
+    // a task of the pool waiting for other tasks runs queued tasks meanwhile - otherwise nested submits
+    // could block all threads of the pool on futures of tasks which are never started
+    template <typename T>
+    void wait(const std::future<T>& result)
+    {
+        if (!is_pool_thread())
+        {
+            result.wait();
+            return;
+        }
+
+        while (result.wait_for(std::chrono::seconds{0}) != std::future_status::ready)
+        {
+            if (!try_run_pending_task())
+                std::this_thread::yield();
+        }
+    }
+};
+
+inline ThreadPool& default_thread_pool()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef VARIADIC_HPP
+#define VARIADIC_HPP
+
+#include <cstddef>
+#include <utility>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// non-recursive access to a type in a pack
+// - recursive TypeAt<I, THead, TTail...> instantiates I class templates for every lookup
+// - __type_pack_element (clang, gcc 14+) is a compiler intrinsic - no instantiations at all
+// - the fallback instantiates one class for the pack and finds Indexed<I, T> base by overload resolution
+
+#if defined(__has_builtin)
+#if __has_builtin(__type_pack_element)
+#define VARIADIC_HAS_TYPE_PACK_ELEMENT
+#endif
+#endif
+
+namespace Variadic
+{
+#ifdef VARIADIC_HAS_TYPE_PACK_ELEMENT
+    template <size_t I, typename... Ts>
+    struct TypeAt
+    {
+        static_assert(I < sizeof...(Ts), "index out of range");
+
+        using type = __type_pack_element<I, Ts...>;
+    };
+#else
+    namespace Details
+    {
+        template <size_t I, typename T>
+        struct Indexed
+        {
+            using type = T;
+        };
+
+        template <typename TIndexes, typename... Ts>
+        struct IndexedPack;
+
+        template <size_t... Is, typename... Ts>
+        struct IndexedPack<std::index_sequence<Is...>, Ts...> : Indexed<Is, Ts>...
+        {
+        };
+
+        template <size_t I, typename T>
+        Indexed<I, T> select(const Indexed<I, T>&); // used only in unevaluated context
+    }
+
+    template <size_t I, typename... Ts>
+    struct TypeAt
+    {
+        static_assert(I < sizeof...(Ts), "index out of range");
+
+        using type = typename decltype(Details::select<I>(
+            std::declval<Details::IndexedPack<std::index_sequence_for<Ts...>, Ts...>>()))::type;
+    };
+#endif
+
+    template <size_t I, typename... Ts>
+    using TypeAt_t = typename TypeAt<I, Ts...>::type;
+
+    template <typename... Ts>
+    using Head_t = TypeAt_t<0, Ts...>;
+
+    template <typename... Ts>
+    using Last_t = TypeAt_t<sizeof...(Ts) - 1, Ts...>;
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include <mutex>
 #include <numeric>
 #include <queue>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -132,4 +133,66 @@ void print(const THead& head, const TTail&... tail)
 TEST_CASE("variadic print")
 {
     print(1, 3.14, "text");
-}
\ No newline at end of file
+}
+
+namespace FoldExpressions
+{
+    // single instantiation for any number of args - recursive versions instantiate print for every suffix of a pack
+    template <typename... TArgs>
+    void print(const TArgs&... args)
+    {
+        (..., (std::cout << args << " "));
+        std::cout << "\n";
+    }
+}
+
+class CoutRedirect
+{
+    std::ostringstream output_;
+    std::streambuf* original_;
+
+public:
+    CoutRedirect()
+        : original_{std::cout.rdbuf(output_.rdbuf())}
+    {
+    }
+
+    ~CoutRedirect()
+    {
+        std::cout.rdbuf(original_);
+    }
+
+    std::string str() const
+    {
+        return output_.str();
+    }
+};
+
+TEST_CASE("variadic print - fold expression gives the same output")
+{
+    std::string recursive_output;
+    std::string constexpr_if_output;
+    std::string fold_output;
+
+    {
+        CoutRedirect redirect;
+        BeforeCpp17::print(1, 3.14, "text");
+        recursive_output = redirect.str();
+    }
+
+    {
+        CoutRedirect redirect;
+        print(1, 3.14, "text");
+        constexpr_if_output = redirect.str();
+    }
+
+    {
+        CoutRedirect redirect;
+        FoldExpressions::print(1, 3.14, "text");
+        fold_output = redirect.str();
+    }
+
+    REQUIRE(fold_output == "1 3.14 text \n");
+    REQUIRE(fold_output == recursive_output);
+    REQUIRE(fold_output == constexpr_if_output);
+}
@@ -0,0 +1,224 @@
+#ifndef AREA_KERNELS_HPP
+#define AREA_KERNELS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define AREA_KERNELS_AVX
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define AREA_KERNELS_SSE2
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// batch kernels for sums of areas computed from int dimensions
+//   sum_scaled_squares(radii, 3.14) - sum of 3.14 * r * r
+//   sum_products(widths, heights)   - sum of w * h
+//   sum_interleaved_products(pairs) - sum of pairs[2i] * pairs[2i + 1] (e.g. {w, h} structs viewed as ints)
+// - ints are converted to doubles in SIMD registers (4 lanes with AVX, 2 lanes with SSE2)
+// - each term is rounded exactly like the scalar expression (factor * r) * r
+// - pairwise summation: blocks of block_size terms are summed in SIMD lanes, block sums are added pairwise,
+//   so the rounding error grows with log(n) instead of n as in a scalar loop
+
+namespace AreaKernels
+{
+    constexpr size_t block_size = 256;
+
+    // adds block sums pairwise - block sums of the same level are merged like carries of a binary counter
+    class PairwiseSum
+    {
+        std::array<double, 64> partials_{};
+        std::array<uint8_t, 64> levels_{};
+        size_t count_{};
+
+    public:
+        void add(double block_sum)
+        {
+            uint8_t level = 0;
+            while (count_ > 0 && levels_[count_ - 1] == level)
+            {
+                block_sum = partials_[--count_] + block_sum;
+                ++level;
+            }
+
+            partials_[count_] = block_sum;
+            levels_[count_] = level;
+            ++count_;
+        }
+
+        double value() const
+        {
+            double sum = 0.0;
+            for (size_t i = count_; i-- > 0;)
+                sum += partials_[i];
+            return sum;
+        }
+    };
+
+    namespace Details
+    {
+#ifdef AREA_KERNELS_AVX
+        inline double horizontal_sum(__m256d sum)
+        {
+            const __m128d half = _mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1));
+            return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+        }
+
+        inline __m256d load_doubles(const int* values)
+        {
+            return _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values)));
+        }
+#elif defined(AREA_KERNELS_SSE2)
+        inline double horizontal_sum(__m128d sum)
+        {
+            return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+        }
+
+        // two ints from values[0..1]
+        inline __m128d load_doubles(const int* values)
+        {
+            return _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(values)));
+        }
+#endif
+
+        // terms: a[i] * factor * b[i] - a & b have the same size <= block_size
+        inline double block_sum(const int* a, const int* b, size_t size, double factor)
+        {
+            size_t i = 0;
+            double sum = 0.0;
+
+#ifdef AREA_KERNELS_AVX
+            const __m256d f = _mm256_set1_pd(factor);
+            __m256d sum_a = _mm256_setzero_pd();
+            __m256d sum_b = _mm256_setzero_pd();
+
+            for (; i + 8 <= size; i += 8)
+            {
+                sum_a = _mm256_add_pd(sum_a, _mm256_mul_pd(_mm256_mul_pd(f, load_doubles(a + i)), load_doubles(b + i)));
+                sum_b = _mm256_add_pd(sum_b, _mm256_mul_pd(_mm256_mul_pd(f, load_doubles(a + i + 4)), load_doubles(b + i + 4)));
+            }
+
+            sum = horizontal_sum(_mm256_add_pd(sum_a, sum_b));
+#elif defined(AREA_KERNELS_SSE2)
+            const __m128d f = _mm_set1_pd(factor);
+            __m128d sum_a = _mm_setzero_pd();
+            __m128d sum_b = _mm_setzero_pd();
+
+            for (; i + 4 <= size; i += 4)
+            {
+                sum_a = _mm_add_pd(sum_a, _mm_mul_pd(_mm_mul_pd(f, load_doubles(a + i)), load_doubles(b + i)));
+                sum_b = _mm_add_pd(sum_b, _mm_mul_pd(_mm_mul_pd(f, load_doubles(a + i + 2)), load_doubles(b + i + 2)));
+            }
+
+            sum = horizontal_sum(_mm_add_pd(sum_a, sum_b));
+#endif
+
+            for (; i < size; ++i)
+                sum += factor * a[i] * b[i];
+
+            return sum;
+        }
+
+        // terms: pairs[2i] * factor * pairs[2i + 1] - size (number of pairs) <= block_size
+        inline double interleaved_block_sum(const int* pairs, size_t size, double factor)
+        {
+            size_t i = 0;
+            double sum = 0.0;
+
+#ifdef AREA_KERNELS_AVX
+            // four pairs a0 b0 a1 b1 | a2 b2 a3 b3 are split into a0 a1 a2 a3 & b0 b1 b2 b3
+            auto load_pairs = [pairs](size_t index, __m256d& a, __m256d& b) {
+                const __m128 low = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pairs + 2 * index)));
+                const __m128 high = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pairs + 2 * index + 4)));
+                a = _mm256_cvtepi32_pd(_mm_castps_si128(_mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0))));
+                b = _mm256_cvtepi32_pd(_mm_castps_si128(_mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1))));
+            };
+
+            const __m256d f = _mm256_set1_pd(factor);
+            __m256d sum_a = _mm256_setzero_pd();
+            __m256d sum_b = _mm256_setzero_pd();
+
+            for (; i + 8 <= size; i += 8)
+            {
+                __m256d a, b;
+                load_pairs(i, a, b);
+                sum_a = _mm256_add_pd(sum_a, _mm256_mul_pd(_mm256_mul_pd(f, a), b));
+                load_pairs(i + 4, a, b);
+                sum_b = _mm256_add_pd(sum_b, _mm256_mul_pd(_mm256_mul_pd(f, a), b));
+            }
+
+            sum = horizontal_sum(_mm256_add_pd(sum_a, sum_b));
+#elif defined(AREA_KERNELS_SSE2)
+            // two pairs a0 b0 a1 b1 are split into a0 a1 & b0 b1
+            auto load_pairs = [pairs](size_t index, __m128d& a, __m128d& b) {
+                const __m128i both = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pairs + 2 * index));
+                a = _mm_cvtepi32_pd(_mm_shuffle_epi32(both, _MM_SHUFFLE(2, 0, 2, 0)));
+                b = _mm_cvtepi32_pd(_mm_shuffle_epi32(both, _MM_SHUFFLE(3, 1, 3, 1)));
+            };
+
+            const __m128d f = _mm_set1_pd(factor);
+            __m128d sum_a = _mm_setzero_pd();
+            __m128d sum_b = _mm_setzero_pd();
+
+            for (; i + 4 <= size; i += 4)
+            {
+                __m128d a, b;
+                load_pairs(i, a, b);
+                sum_a = _mm_add_pd(sum_a, _mm_mul_pd(_mm_mul_pd(f, a), b));
+                load_pairs(i + 2, a, b);
+                sum_b = _mm_add_pd(sum_b, _mm_mul_pd(_mm_mul_pd(f, a), b));
+            }
+
+            sum = horizontal_sum(_mm_add_pd(sum_a, sum_b));
+#endif
+
+            for (; i < size; ++i)
+                sum += factor * pairs[2 * i] * pairs[2 * i + 1];
+
+            return sum;
+        }
+    }
+
+    // accumulates terms a[i] * factor * b[i] - block by block
+    inline void accumulate(PairwiseSum& total, std::span<const int> a, std::span<const int> b, double factor = 1.0)
+    {
+        for (size_t offset = 0; offset < a.size(); offset += block_size)
+            total.add(Details::block_sum(a.data() + offset, b.data() + offset, std::min(block_size, a.size() - offset), factor));
+    }
+
+    // accumulates terms pairs[2i] * factor * pairs[2i + 1] - pairs has an even size
+    inline void accumulate_interleaved(PairwiseSum& total, std::span<const int> pairs, double factor = 1.0)
+    {
+        const size_t size = pairs.size() / 2;
+        for (size_t offset = 0; offset < size; offset += block_size)
+            total.add(Details::interleaved_block_sum(pairs.data() + 2 * offset, std::min(block_size, size - offset), factor));
+    }
+
+    inline double sum_scaled_squares(std::span<const int> values, double factor)
+    {
+        PairwiseSum total;
+        accumulate(total, values, values, factor);
+        return total.value();
+    }
+
+    inline double sum_products(std::span<const int> a, std::span<const int> b)
+    {
+        PairwiseSum total;
+        accumulate(total, a, b);
+        return total.value();
+    }
+
+    inline double sum_interleaved_products(std::span<const int> pairs)
+    {
+        PairwiseSum total;
+        accumulate_interleaved(total, pairs);
+        return total.value();
+    }
+}
+
+#endif
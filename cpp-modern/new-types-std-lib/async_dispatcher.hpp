@@ -0,0 +1,408 @@
+#ifndef ASYNC_DISPATCHER_HPP
+#define ASYNC_DISPATCHER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "rcu.hpp"
+#include "signal.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// async_dispatcher<T> - asynchronous delivery of notifications
+//   monitor.temp_changed.connect([&dispatcher](std::span<const double> temps) { dispatcher.post(temps); });
+// - each subscriber has its own SPSC ring buffer - post() (a single producer thread) only enqueues
+// - handlers are executed by a pool of workers - a subscriber is served always by the same worker
+// - back-pressure policy for a full ring buffer of a subscriber:
+//   * block - the producer waits for a free slot (a subscriber disconnected meanwhile is skipped)
+//   * drop_oldest - the oldest queued notification is dropped
+//   * coalesce_latest - all queued notifications are dropped - a slow subscriber gets only the latest one
+// - per subscriber metrics: delivered, dropped & coalesced notifications, mean & max latency (post -> handler done)
+// - after disconnect(id) returns the handler of id is not running and is never called again
+//   (unless disconnect is called by the handler itself) - objects captured by the handler may be destroyed
+
+namespace Signals
+{
+    enum class BackPressure
+    {
+        block,
+        drop_oldest,
+        coalesce_latest
+    };
+
+    struct DeliveryStats
+    {
+        uint64_t posted{};
+        uint64_t delivered{};
+        uint64_t dropped{};
+        uint64_t coalesced{};
+        std::chrono::nanoseconds mean_latency{};
+        std::chrono::nanoseconds max_latency{};
+    };
+
+    namespace Details
+    {
+        inline int64_t now_ns()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // single producer, single consumer - a pop is committed with CAS on head,
+        // so the producer may also drop queued items (head is advanced by the producer)
+        template <typename T>
+        class SpscRing
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "notifications are copied into atomic slots");
+
+            std::vector<std::atomic<T>> values_;
+            std::vector<std::atomic<int64_t>> timestamps_;
+            uint64_t mask_;
+            alignas(64) std::atomic<uint64_t> head_{0};
+            alignas(64) std::atomic<uint64_t> tail_{0};
+
+        public:
+            explicit SpscRing(size_t capacity)
+                : values_(std::bit_ceil(std::max<size_t>(capacity, 1)))
+                , timestamps_(values_.size())
+                , mask_{values_.size() - 1}
+            {
+            }
+
+            size_t capacity() const
+            {
+                return values_.size();
+            }
+
+            // returns number of items dropped to make space for value
+            // block policy: on_full() is called while the producer waits - if it returns false (the consumer
+            // is gone and the ring is never drained) value is discarded
+            template <typename TOnFull>
+            uint64_t push(const T& value, int64_t timestamp, BackPressure policy, TOnFull on_full)
+            {
+                const uint64_t tail = tail_.load(std::memory_order_relaxed);
+                uint64_t dropped = 0;
+
+                for (uint64_t head = head_.load(std::memory_order_acquire); tail - head >= capacity();)
+                {
+                    switch (policy)
+                    {
+                    case BackPressure::block:
+                        if (!on_full())
+                            return 0;
+                        std::this_thread::yield();
+                        head = head_.load(std::memory_order_acquire);
+                        break;
+                    case BackPressure::drop_oldest:
+                        if (head_.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+                            dropped = 1;
+                        break;
+                    case BackPressure::coalesce_latest:
+                        if (head_.compare_exchange_weak(head, tail, std::memory_order_acq_rel, std::memory_order_acquire))
+                        {
+                            dropped = tail - head;
+                            head = tail;
+                        }
+                        break;
+                    }
+
+                    if (dropped)
+                        break;
+                }
+
+                values_[tail & mask_].store(value, std::memory_order_release);
+                timestamps_[tail & mask_].store(timestamp, std::memory_order_release);
+                tail_.store(tail + 1, std::memory_order_release);
+
+                return dropped;
+            }
+
+            bool pop(T& value, int64_t& timestamp)
+            {
+                uint64_t head = head_.load(std::memory_order_acquire);
+
+                while (head != tail_.load(std::memory_order_acquire))
+                {
+                    const T candidate = values_[head & mask_].load(std::memory_order_acquire);
+                    const int64_t candidate_timestamp = timestamps_[head & mask_].load(std::memory_order_acquire);
+
+                    // fails if the item was dropped (and maybe overwritten) by the producer
+                    if (head_.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+                    {
+                        value = candidate;
+                        timestamp = candidate_timestamp;
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+        };
+    }
+
+    template <typename T>
+    class async_dispatcher
+    {
+        struct Subscriber
+        {
+            connection_id id;
+            size_t worker;
+            BackPressure policy;
+            std::function<void(const T&)> handler;
+            Details::SpscRing<T> ring;
+            std::atomic<bool> is_connected{true}; // cleared by disconnect - a producer blocked by the ring stops waiting
+
+            std::atomic<uint64_t> posted{};
+            std::atomic<uint64_t> delivered{};
+            std::atomic<uint64_t> dropped{};
+            std::atomic<uint64_t> coalesced{};
+            std::atomic<int64_t> total_latency_ns{};
+            std::atomic<int64_t> max_latency_ns{};
+
+            Subscriber(connection_id id, size_t worker, BackPressure policy, std::function<void(const T&)> handler, size_t capacity)
+                : id{id}
+                , worker{worker}
+                , policy{policy}
+                , handler{std::move(handler)}
+                , ring{capacity}
+            {
+            }
+
+            bool is_idle() const
+            {
+                return delivered + dropped + coalesced == posted;
+            }
+        };
+
+        struct Worker
+        {
+            alignas(64) std::atomic<uint64_t> signal{};
+            std::atomic<uint64_t> passes{}; // odd while the worker delivers notifications
+        };
+
+        static constexpr size_t max_batch_per_subscriber = 64; // fairness between subscribers of a worker
+
+        Rcu::rcu_ptr<std::vector<std::shared_ptr<Subscriber>>> subscribers_;
+        connection_id next_id_ = 1; // guarded by the writers lock of subscribers_
+        std::vector<Worker> workers_;
+        std::atomic<bool> is_stopped_{false};
+        std::vector<std::jthread> threads_;
+
+        size_t deliver(size_t worker_index)
+        {
+            return subscribers_.read([worker_index](const auto& subscribers) {
+                size_t count = 0;
+
+                for (const auto& subscriber : subscribers)
+                {
+                    if (subscriber->worker != worker_index)
+                        continue;
+
+                    T value;
+                    int64_t timestamp;
+                    for (size_t i = 0; i < max_batch_per_subscriber && subscriber->ring.pop(value, timestamp); ++i, ++count)
+                    {
+                        subscriber->handler(value);
+
+                        const int64_t latency = Details::now_ns() - timestamp;
+                        subscriber->total_latency_ns.fetch_add(latency, std::memory_order_relaxed);
+                        if (latency > subscriber->max_latency_ns.load(std::memory_order_relaxed))
+                            subscriber->max_latency_ns.store(latency, std::memory_order_relaxed);
+                        subscriber->delivered.fetch_add(1, std::memory_order_release);
+                    }
+                }
+
+                return count;
+            });
+        }
+
+        void run(size_t worker_index)
+        {
+            Worker& worker = workers_[worker_index];
+
+            while (true)
+            {
+                const uint64_t signal = worker.signal.load(std::memory_order_acquire);
+                const bool is_stopped = is_stopped_.load(std::memory_order_acquire);
+
+                worker.passes.fetch_add(1, std::memory_order_seq_cst); // before the snapshot of subscribers is read
+                const size_t delivered_count = deliver(worker_index);
+                worker.passes.fetch_add(1, std::memory_order_release);
+
+                if (delivered_count == 0)
+                {
+                    if (is_stopped)
+                        return;
+                    worker.signal.wait(signal, std::memory_order_acquire);
+                }
+            }
+        }
+
+        void wake_worker(size_t worker_index)
+        {
+            workers_[worker_index].signal.fetch_add(1, std::memory_order_release);
+            workers_[worker_index].signal.notify_one();
+        }
+
+        void wake_workers()
+        {
+            for (size_t i = 0; i < workers_.size(); ++i)
+                wake_worker(i);
+        }
+
+        // a pass which started after the subscriber was removed can't see it - only a pass in progress is waited for
+        void wait_until_quiescent(size_t worker_index) const
+        {
+            if (threads_[worker_index].get_id() == std::this_thread::get_id())
+                return; // called by a handler
+
+            const std::atomic<uint64_t>& passes = workers_[worker_index].passes;
+            const uint64_t pass = passes.load(std::memory_order_seq_cst);
+            if (pass % 2 == 0)
+                return;
+
+            while (passes.load(std::memory_order_acquire) == pass)
+                std::this_thread::yield();
+        }
+
+    public:
+        explicit async_dispatcher(size_t workers_count = 1)
+            : workers_(std::max<size_t>(workers_count, 1))
+        {
+            for (size_t i = 0; i < workers_.size(); ++i)
+                threads_.emplace_back([this, i] { run(i); });
+        }
+
+        async_dispatcher(const async_dispatcher&) = delete;
+        async_dispatcher& operator=(const async_dispatcher&) = delete;
+
+        // queued notifications are delivered before workers are stopped
+        ~async_dispatcher()
+        {
+            is_stopped_.store(true, std::memory_order_release);
+            wake_workers();
+            threads_.clear();
+        }
+
+        template <typename F>
+            requires std::is_invocable_v<F&, const T&>
+        connection_id connect(F handler, BackPressure policy = BackPressure::block, size_t capacity = 1024)
+        {
+            connection_id id{};
+
+            subscribers_.update([&](auto& subscribers) {
+                id = next_id_++;
+                subscribers.push_back(std::make_shared<Subscriber>(id, id % workers_.size(), policy, std::move(handler), capacity));
+            });
+
+            return id;
+        }
+
+        // notifications queued for the subscriber are discarded
+        // waits until a call of the handler in progress (on a worker thread) is finished
+        bool disconnect(connection_id id)
+        {
+            std::optional<size_t> worker_index;
+
+            subscribers_.update([&](auto& subscribers) {
+                auto it = std::find_if(subscribers.begin(), subscribers.end(), [id](const auto& subscriber) { return subscriber->id == id; });
+                if (it != subscribers.end())
+                {
+                    worker_index = (*it)->worker;
+                    (*it)->is_connected.store(false, std::memory_order_release);
+                    subscribers.erase(it);
+                }
+            });
+
+            if (worker_index)
+                wait_until_quiescent(*worker_index);
+
+            return worker_index.has_value();
+        }
+
+        void post(const T& value)
+        {
+            post(std::span<const T>{&value, 1});
+        }
+
+        void post(std::span<const T> values)
+        {
+            if (values.empty())
+                return;
+
+            const int64_t timestamp = Details::now_ns();
+            uint64_t notified_workers = 0; // bit i - worker i (workers above 63 are always woken)
+
+            subscribers_.read([&](const auto& subscribers) {
+                for (const auto& subscriber : subscribers)
+                {
+                    subscriber->posted.fetch_add(values.size(), std::memory_order_relaxed);
+                    if (subscriber->worker < 64)
+                        notified_workers |= uint64_t{1} << subscriber->worker;
+
+                    for (const auto& value : values)
+                    {
+                        const uint64_t dropped = subscriber->ring.push(value, timestamp, subscriber->policy,
+                            [&] {
+                                wake_worker(subscriber->worker);
+                                return subscriber->is_connected.load(std::memory_order_acquire);
+                            });
+
+                        if (dropped > 0)
+                            (subscriber->policy == BackPressure::drop_oldest ? subscriber->dropped : subscriber->coalesced)
+                                .fetch_add(dropped, std::memory_order_relaxed);
+                    }
+                }
+            });
+
+            // after all pushes - a worker woken before a push to its other subscriber could miss it
+            for (; notified_workers != 0; notified_workers &= notified_workers - 1)
+                wake_worker(std::countr_zero(notified_workers));
+            for (size_t i = 64; i < workers_.size(); ++i)
+                wake_worker(i);
+        }
+
+        std::optional<DeliveryStats> stats(connection_id id) const
+        {
+            return subscribers_.read([id](const auto& subscribers) -> std::optional<DeliveryStats> {
+                for (const auto& subscriber : subscribers)
+                {
+                    if (subscriber->id != id)
+                        continue;
+
+                    DeliveryStats stats;
+                    stats.delivered = subscriber->delivered.load(std::memory_order_acquire);
+                    stats.posted = subscriber->posted.load(std::memory_order_relaxed);
+                    stats.dropped = subscriber->dropped.load(std::memory_order_relaxed);
+                    stats.coalesced = subscriber->coalesced.load(std::memory_order_relaxed);
+                    stats.max_latency = std::chrono::nanoseconds{subscriber->max_latency_ns.load(std::memory_order_relaxed)};
+                    if (stats.delivered > 0)
+                        stats.mean_latency = std::chrono::nanoseconds{
+                            subscriber->total_latency_ns.load(std::memory_order_relaxed) / static_cast<int64_t>(stats.delivered)};
+                    return stats;
+                }
+
+                return std::nullopt;
+            });
+        }
+
+        // waits until all posted notifications are delivered (or dropped)
+        void wait_idle() const
+        {
+            while (!subscribers_.read([](const auto& subscribers) {
+                return std::all_of(subscribers.begin(), subscribers.end(), [](const auto& subscriber) { return subscriber->is_idle(); });
+            }))
+                std::this_thread::yield();
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef BENCHMARK_UTILS_HPP
+#define BENCHMARK_UTILS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string_view>
+#include <type_traits>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// helper of hidden [.][benchmark] tests
+//   Benchmark::measure("std::from_chars", [&] { ...; return count; }, " values");
+//   prints: std::from_chars: 12.345ms - 1000000 values
+// - a result of f (if f returns a value) & details are printed after the time - a result keeps
+//   the measured work from being optimized away
+// - returns the elapsed time (e.g. for throughput)
+
+namespace Benchmark
+{
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    constexpr size_t megabytes(size_t bytes)
+    {
+        return bytes / 1024 / 1024;
+    }
+
+    template <typename F, typename... TDetails>
+    Milliseconds measure(std::string_view description, F&& f, const TDetails&... details)
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+
+        if constexpr (std::is_void_v<std::invoke_result_t<F&>>)
+        {
+            f();
+            const Milliseconds elapsed = std::chrono::high_resolution_clock::now() - start;
+            std::cout << description << ": " << elapsed.count() << "ms";
+            if constexpr (sizeof...(details) > 0)
+                ((std::cout << " - ") << ... << details);
+            std::cout << "\n";
+            return elapsed;
+        }
+        else
+        {
+            const auto result = f();
+            const Milliseconds elapsed = std::chrono::high_resolution_clock::now() - start;
+            std::cout << description << ": " << elapsed.count() << "ms - " << result;
+            (std::cout << ... << details) << "\n";
+            return elapsed;
+        }
+    }
+}
+
+#endif
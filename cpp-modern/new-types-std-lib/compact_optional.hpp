@@ -0,0 +1,197 @@
+#ifndef COMPACT_OPTIONAL_HPP
+#define COMPACT_OPTIONAL_HPP
+
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// compact_optional<T, Sentinel> - optional without an engaged flag: the empty state is stored in the value itself
+//   compact_optional<int, -1> - the sentinel value means "empty" (it can't be stored as a value)
+//   compact_optional<int*>    - automatic niche: an address of the last byte of the address space (nullptr is a valid value)
+//   compact_optional<Enum>    - automatic niche: the max value of the underlying type (must not be an enumerator,
+//                               the enum must be scoped or have a fixed underlying type)
+//   compact_optional<bool>    - automatic niche: a byte which is neither false nor true
+// - sizeof(compact_optional<T, ...>) == sizeof(T) - arrays of optionals are as dense as arrays of values
+
+namespace CompactOptional
+{
+    namespace Details
+    {
+        template <typename T, auto... Sentinel>
+        struct Niche;
+
+        template <typename T, auto Sentinel>
+        struct Niche<T, Sentinel>
+        {
+            static void set_empty(T& value) noexcept { value = static_cast<T>(Sentinel); }
+            static bool is_empty(const T& value) noexcept { return value == static_cast<T>(Sentinel); }
+        };
+
+        template <typename T>
+            requires std::is_pointer_v<T>
+        struct Niche<T>
+        {
+            static T empty() noexcept { return reinterpret_cast<T>(std::numeric_limits<uintptr_t>::max()); }
+            static void set_empty(T& value) noexcept { value = empty(); }
+            static bool is_empty(const T& value) noexcept { return value == empty(); }
+        };
+
+        // T{underlying value} compiles only for enums with a fixed underlying type (all scoped enums)
+        template <typename T>
+        concept EnumWithFixedUnderlyingType = std::is_enum_v<T> && requires { T{std::underlying_type_t<T>{}}; };
+
+        // without a fixed underlying type the max value of the underlying type may be out of the range of the enum (UB)
+        template <typename T>
+            requires std::is_enum_v<T>
+        struct Niche<T>
+        {
+            static_assert(EnumWithFixedUnderlyingType<T>, "automatic niche requires an enum with a fixed underlying type - use an explicit sentinel");
+
+            static constexpr T empty = static_cast<T>(std::numeric_limits<std::underlying_type_t<T>>::max());
+            static void set_empty(T& value) noexcept { value = empty; }
+            static bool is_empty(const T& value) noexcept { return value == empty; }
+        };
+
+        // the bool object is never read when the byte is neither 0 nor 1
+        template <>
+        struct Niche<bool>
+        {
+            static constexpr unsigned char empty = 2;
+            static void set_empty(bool& value) noexcept { std::memset(&value, empty, 1); }
+
+            static bool is_empty(const bool& value) noexcept
+            {
+                unsigned char byte;
+                std::memcpy(&byte, &value, 1);
+                return byte == empty;
+            }
+        };
+    }
+
+    template <typename T, auto... Sentinel>
+    class compact_optional
+    {
+        static_assert(sizeof...(Sentinel) <= 1, "at most one sentinel value");
+        static_assert(std::is_trivially_copyable_v<T>, "the empty state is stored in a value");
+
+        using Niche = Details::Niche<T, Sentinel...>;
+
+        T value_;
+
+        void check_not_empty_state() const
+        {
+            if (Niche::is_empty(value_))
+                throw std::invalid_argument("value is reserved for the empty state of compact_optional");
+        }
+
+    public:
+        using value_type = T;
+
+        compact_optional() noexcept
+        {
+            Niche::set_empty(value_);
+        }
+
+        compact_optional(std::nullopt_t) noexcept
+            : compact_optional()
+        {
+        }
+
+        compact_optional(const T& value)
+            : value_{value}
+        {
+            check_not_empty_state();
+        }
+
+        template <typename... TArgs>
+        explicit compact_optional(std::in_place_t, TArgs&&... args)
+            : value_(std::forward<TArgs>(args)...)
+        {
+            check_not_empty_state();
+        }
+
+        compact_optional& operator=(std::nullopt_t) noexcept
+        {
+            reset();
+            return *this;
+        }
+
+        compact_optional& operator=(const T& value)
+        {
+            return *this = compact_optional(value);
+        }
+
+        template <typename... TArgs>
+        T& emplace(TArgs&&... args)
+        {
+            *this = compact_optional(std::in_place, std::forward<TArgs>(args)...);
+            return value_;
+        }
+
+        void reset() noexcept
+        {
+            Niche::set_empty(value_);
+        }
+
+        bool has_value() const noexcept
+        {
+            return !Niche::is_empty(value_);
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return has_value();
+        }
+
+        T& operator*() & noexcept { return value_; }
+        const T& operator*() const& noexcept { return value_; }
+
+        T* operator->() noexcept { return &value_; }
+        const T* operator->() const noexcept { return &value_; }
+
+        T& value() &
+        {
+            if (!has_value())
+                throw std::bad_optional_access{};
+            return value_;
+        }
+
+        const T& value() const&
+        {
+            if (!has_value())
+                throw std::bad_optional_access{};
+            return value_;
+        }
+
+        template <typename U>
+        T value_or(U&& default_value) const
+        {
+            return has_value() ? value_ : static_cast<T>(std::forward<U>(default_value));
+        }
+
+        bool operator==(std::nullopt_t) const noexcept
+        {
+            return !has_value();
+        }
+
+        bool operator==(const compact_optional& other) const noexcept
+        {
+            return has_value() == other.has_value() && (!has_value() || value_ == other.value_);
+        }
+
+        template <typename U>
+            requires(!std::is_same_v<U, compact_optional>) && std::equality_comparable_with<T, U>
+        bool operator==(const U& other) const
+        {
+            return has_value() && value_ == other;
+        }
+    };
+}
+
+#endif
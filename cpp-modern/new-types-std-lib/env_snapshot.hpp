@@ -0,0 +1,173 @@
+#ifndef ENV_SNAPSHOT_HPP
+#define ENV_SNAPSHOT_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _WIN32
+#include <stdlib.h>
+#define ENV_SNAPSHOT_ENVIRON _environ
+#else
+extern char** environ;
+#define ENV_SNAPSHOT_ENVIRON environ
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// immutable snapshot of the environment taken at process startup
+//   Environment::get("HOME")      - name hashed at runtime
+//   Environment::get("HOME"_env)  - name hashed at compile time
+// - names & values are copied once into one buffer - later setenv/putenv calls don't affect the snapshot
+// - lookups: open addressing hash table (linear probing) - O(1), no locks, no allocations
+
+namespace Environment
+{
+    constexpr uint64_t hash(std::string_view text) noexcept // FNV-1a
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (char c : text)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    struct Key
+    {
+        std::string_view name;
+        uint64_t hash;
+    };
+
+    class Snapshot
+    {
+        struct Entry
+        {
+            uint64_t hash{};
+            size_t name_offset{};
+            size_t name_size{};
+            size_t value_offset{};
+            size_t value_size{};
+        };
+
+        std::string buffer_;
+        std::vector<Entry> entries_; // size is a power of 2, empty entries have name_size == 0
+        size_t size_{};
+
+        std::string_view name(const Entry& entry) const
+        {
+            return std::string_view{buffer_}.substr(entry.name_offset, entry.name_size);
+        }
+
+        std::string_view value(const Entry& entry) const
+        {
+            return std::string_view{buffer_}.substr(entry.value_offset, entry.value_size);
+        }
+
+        void insert(const Entry& entry)
+        {
+            const size_t mask = entries_.size() - 1;
+
+            for (size_t index = entry.hash & mask;; index = (index + 1) & mask)
+            {
+                if (entries_[index].name_size == 0)
+                {
+                    entries_[index] = entry;
+                    ++size_;
+                    return;
+                }
+
+                if (name(entries_[index]) == name(entry)) // the first definition wins - like getenv
+                    return;
+            }
+        }
+
+    public:
+        // vars - null terminated array of "NAME=value" strings
+        explicit Snapshot(char** vars)
+        {
+            std::vector<Entry> parsed;
+
+            for (char** var = vars; var && *var; ++var)
+            {
+                const std::string_view text{*var};
+                const size_t separator = text.find('=');
+                if (separator == 0 || separator == std::string_view::npos)
+                    continue;
+
+                Entry entry;
+                entry.hash = Environment::hash(text.substr(0, separator));
+                entry.name_offset = buffer_.size();
+                entry.name_size = separator;
+                entry.value_offset = buffer_.size() + separator + 1;
+                entry.value_size = text.size() - separator - 1;
+
+                buffer_ += text;
+                parsed.push_back(entry);
+            }
+
+            entries_.resize(std::bit_ceil(2 * parsed.size() + 1)); // load factor <= 0.5
+            for (const auto& entry : parsed)
+                insert(entry);
+        }
+
+        size_t size() const
+        {
+            return size_;
+        }
+
+        std::optional<std::string_view> get(const Key& key) const
+        {
+            const size_t mask = entries_.size() - 1;
+
+            for (size_t index = key.hash & mask; entries_[index].name_size != 0; index = (index + 1) & mask)
+            {
+                if (entries_[index].hash == key.hash && name(entries_[index]) == key.name)
+                    return value(entries_[index]);
+            }
+
+            return std::nullopt;
+        }
+
+        std::optional<std::string_view> get(std::string_view name) const
+        {
+            return get(Key{name, Environment::hash(name)});
+        }
+    };
+
+    // initialized before main (see Details::startup_snapshot) - later calls only read the snapshot
+    inline const Snapshot& snapshot()
+    {
+        static const Snapshot startup_snapshot{ENV_SNAPSHOT_ENVIRON};
+        return startup_snapshot;
+    }
+
+    namespace Details
+    {
+        inline const Snapshot& startup_snapshot = snapshot();
+    }
+
+    inline std::optional<std::string_view> get(std::string_view name)
+    {
+        return snapshot().get(name);
+    }
+
+    inline std::optional<std::string_view> get(const Key& key)
+    {
+        return snapshot().get(key);
+    }
+
+    namespace Literals
+    {
+        consteval Key operator""_env(const char* name, size_t size)
+        {
+            return Key{std::string_view{name, size}, hash(std::string_view{name, size})};
+        }
+    }
+}
+
+#endif
@@ -1,6 +1,17 @@
 #include "catch.hpp"
+#include "area_kernels.hpp"
+#include "benchmark_utils.hpp"
+#include "variant_vector.hpp"
 
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <span>
 #include <string>
 #include <variant>
 #include <vector>
@@ -41,10 +52,13 @@ struct overloaded : TClosures...
 	using TClosures::operator()...;
 };
 
+template <typename... TClosures>
+overloaded(TClosures...) -> overloaded<TClosures...>; // gcc 12 doesn't deduce from aggregate initialization with ()
+
+using Shape = std::variant<Circle, Rectangle, Square>;
+
 TEST_CASE("visit a shape variant and calculate area")
 {
-    using Shape = std::variant<Circle, Rectangle, Square>;
-
     std::vector<Shape> shapes = {Circle {1}, Square {10}, Rectangle {10, 1}};
 
     double total_area {};
@@ -67,6 +81,374 @@ TEST_CASE("visit a shape variant and calculate area")
     }
 }
 
+///////////////////////////////////////////////////////////
+// structure of arrays - each kind of shape in its own array
+
+using Shapes = VariantVector::variant_vector<Circle, Rectangle, Square>;
+
+// one tight loop per array - dimensions are multiplied as doubles (int products overflow for large dimensions);
+// four independent sums break the dependency chain of a single sum, so a compiler can keep them in SIMD lanes
+template <typename T, typename TArea>
+double sum_areas(std::span<const T> shapes, TArea area)
+{
+    std::array<double, 4> sums {};
+
+    size_t i = 0;
+    for (; i + 4 <= shapes.size(); i += 4)
+        for (size_t lane = 0; lane < 4; ++lane)
+            sums[lane] += area(shapes[i + lane]);
+
+    for (; i < shapes.size(); ++i)
+        sums[0] += area(shapes[i]);
+
+    return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+// no dispatch per shape
+double total_area(const Shapes& shapes)
+{
+    return sum_areas(shapes.get<Circle>(), [](const Circle& circ) { return 3.14 * circ.radius * circ.radius; })
+        + sum_areas(shapes.get<Rectangle>(), [](const Rectangle& rect) { return static_cast<double>(rect.width) * rect.height; })
+        + sum_areas(shapes.get<Square>(), [](const Square& square) { return static_cast<double>(square.size) * square.size; });
+}
+
+TEST_CASE("variant_vector of shapes")
+{
+    Shapes shapes;
+
+    shapes.push_back(Circle {1});
+    shapes.push_back(Shape {Square {10}});
+    shapes.emplace_back<Rectangle>(10, 1);
+    shapes.push_back(Circle {2});
+
+    REQUIRE(shapes.size() == 4);
+    REQUIRE(shapes.count<Circle>() == 2);
+    REQUIRE(shapes.get<Rectangle>()[0].width == 10);
+    REQUIRE(total_area(shapes) == Approx(125.7));
+
+    SECTION("large dimensions")
+    {
+        constexpr int max = std::numeric_limits<int>::max();
+
+        Shapes large_shapes;
+        large_shapes.push_back(Circle {max});
+        large_shapes.push_back(Circle {max});
+        large_shapes.push_back(Rectangle {max, max});
+
+        REQUIRE(total_area(large_shapes) == Approx(2 * 3.14 * max * max + 1.0 * max * max));
+    }
+
+    SECTION("shapes are grouped by type")
+    {
+        std::vector<int> sizes;
+        shapes.for_each(overloaded {
+            [&](const Circle& c) { sizes.push_back(c.radius); },
+            [&](const Rectangle& r) { sizes.push_back(r.width * r.height); },
+            [&](const Square& s) { sizes.push_back(s.size); }
+        });
+
+        REQUIRE(sizes == std::vector {1, 2, 10, 10});
+        REQUIRE_THROWS_AS(shapes.at(0), std::logic_error);
+    }
+
+    SECTION("order index preserves the insertion order")
+    {
+        Shapes ordered_shapes {VariantVector::Ordering::preserved};
+        for (const Shape& shape : std::vector<Shape> {Circle {1}, Square {10}, Rectangle {10, 1}, Circle {2}})
+            ordered_shapes.push_back(shape);
+
+        std::vector<size_t> indexes;
+        ordered_shapes.for_each([&](const auto& shape) { indexes.push_back(Shape {shape}.index()); });
+
+        REQUIRE(indexes == std::vector<size_t> {0, 2, 1, 0});
+        REQUIRE(std::get<Circle>(ordered_shapes.at(3)).radius == 2);
+        REQUIRE(std::get<Square>(ordered_shapes.at(1)).size == 10);
+        REQUIRE_THROWS_AS(ordered_shapes.at(4), std::out_of_range);
+    }
+}
+
+TEST_CASE("std::vector<Shape> vs. variant_vector", "[.][benchmark]")
+{
+    constexpr size_t count = 10'000'000;
+
+    std::mt19937_64 rnd {665};
+    std::vector<Shape> shapes;
+    Shapes soa_shapes;
+    shapes.reserve(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const int size = static_cast<int>(rnd() % 100);
+        switch (rnd() % 3)
+        {
+            case 0: shapes.push_back(Circle {size}); break;
+            case 1: shapes.push_back(Rectangle {size, size + 1}); break;
+            default: shapes.push_back(Square {size}); break;
+        }
+        soa_shapes.push_back(shapes.back());
+    }
+
+    const auto area = overloaded(
+        [](const Circle& circ) -> double { return 3.14 * circ.radius * circ.radius; },
+        [](const Rectangle& rect) -> double { return rect.width * rect.height; },
+        [](const Square& square) -> double { return square.size * square.size; }
+    );
+
+    Benchmark::measure("std::vector<Shape> + std::visit", [&] {
+        double total_area {};
+        for (const auto& shape : shapes)
+            total_area += std::visit(area, shape);
+        return total_area;
+    }, " total area, ", Benchmark::megabytes(shapes.size() * sizeof(Shape)), "MB");
+
+    const size_t soa_bytes = soa_shapes.get<Circle>().size_bytes() + soa_shapes.get<Rectangle>().size_bytes() + soa_shapes.get<Square>().size_bytes();
+    Benchmark::measure("variant_vector                 ", [&] { return total_area(soa_shapes); }, " total area, ",
+        Benchmark::megabytes(soa_bytes), "MB");
+}
+
+///////////////////////////////////////////////////////////
+// batch SIMD area kernels
+// - arrays of one type of shapes are packed arrays of ints - the kernels run directly over them
+// - dimensions of mixed shapes are gathered into blocks of ints
+
+// dimensions of shapes viewed as a packed array of ints - no copy
+template <typename T>
+std::span<const int> as_ints(std::span<const T> shapes)
+{
+    static_assert(std::is_standard_layout_v<T> && sizeof(T) % sizeof(int) == 0 && alignof(T) == alignof(int),
+        "a shape must consist of int members only");
+
+    return {reinterpret_cast<const int*>(shapes.data()), shapes.size() * (sizeof(T) / sizeof(int))};
+}
+
+double total_area(std::span<const Circle> circles)
+{
+    return AreaKernels::sum_scaled_squares(as_ints(circles), 3.14);
+}
+
+double total_area(std::span<const Rectangle> rectangles)
+{
+    return AreaKernels::sum_interleaved_products(as_ints(rectangles)); // width, height pairs
+}
+
+double total_area(std::span<const Square> squares)
+{
+    return AreaKernels::sum_scaled_squares(as_ints(squares), 1.0);
+}
+
+class AreaAccumulator
+{
+    std::array<int, AreaKernels::block_size> radii_, widths_, heights_, sizes_;
+    size_t circles_count_ {}, rectangles_count_ {}, squares_count_ {};
+    AreaKernels::PairwiseSum circles_area_, rectangles_area_, squares_area_;
+
+    void flush_circles()
+    {
+        const std::span<const int> radii {radii_.data(), circles_count_};
+        AreaKernels::accumulate(circles_area_, radii, radii, 3.14);
+        circles_count_ = 0;
+    }
+
+    void flush_rectangles()
+    {
+        AreaKernels::accumulate(rectangles_area_, {widths_.data(), rectangles_count_}, {heights_.data(), rectangles_count_});
+        rectangles_count_ = 0;
+    }
+
+    void flush_squares()
+    {
+        const std::span<const int> sizes {sizes_.data(), squares_count_};
+        AreaKernels::accumulate(squares_area_, sizes, sizes);
+        squares_count_ = 0;
+    }
+
+public:
+    void add(const Circle& circ)
+    {
+        radii_[circles_count_++] = circ.radius;
+        if (circles_count_ == AreaKernels::block_size)
+            flush_circles();
+    }
+
+    void add(const Rectangle& rect)
+    {
+        widths_[rectangles_count_] = rect.width;
+        heights_[rectangles_count_++] = rect.height;
+        if (rectangles_count_ == AreaKernels::block_size)
+            flush_rectangles();
+    }
+
+    void add(const Square& square)
+    {
+        sizes_[squares_count_++] = square.size;
+        if (squares_count_ == AreaKernels::block_size)
+            flush_squares();
+    }
+
+    void add(const Shape& shape)
+    {
+        std::visit([this](const auto& shp) { add(shp); }, shape);
+    }
+
+    double total()
+    {
+        flush_circles();
+        flush_rectangles();
+        flush_squares();
+        return circles_area_.value() + rectangles_area_.value() + squares_area_.value();
+    }
+};
+
+double total_area(std::span<const Shape> shapes)
+{
+    AreaAccumulator accumulator;
+    for (const auto& shape : shapes)
+        accumulator.add(shape);
+    return accumulator.total();
+}
+
+TEST_CASE("area kernels")
+{
+    std::mt19937_64 rnd {42};
+    std::vector<int> a(3 * AreaKernels::block_size + 7), b(a.size());
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = static_cast<int>(rnd() % 2001) - 1000;
+        b[i] = static_cast<int>(rnd() % 2001) - 1000;
+    }
+
+    // all partial sums are integers - exact in doubles
+    for (size_t size : {0, 1, 3, 7, 8, 9, 255, 256, 257, 775})
+    {
+        const std::span<const int> as {a.data(), size}, bs {b.data(), size};
+        REQUIRE(AreaKernels::sum_products(as, bs) == std::inner_product(as.begin(), as.end(), bs.begin(), int64_t {}));
+        REQUIRE(AreaKernels::sum_scaled_squares(as, 2.0) == 2 * std::inner_product(as.begin(), as.end(), as.begin(), int64_t {}));
+
+        // a0 b0 a1 b1 ... - the same terms as sum_products of a & b
+        std::vector<int> pairs;
+        for (size_t i = 0; i < size; ++i)
+            pairs.insert(pairs.end(), {a[i], b[i]});
+        REQUIRE(AreaKernels::sum_interleaved_products(pairs) == std::inner_product(as.begin(), as.end(), bs.begin(), int64_t {}));
+    }
+}
+
+TEST_CASE("total_area of a span of shapes")
+{
+    std::vector<Shape> shapes = {Circle {1}, Square {10}, Rectangle {10, 1}};
+
+    REQUIRE(total_area(shapes) == Approx(113.14));
+    REQUIRE(total_area(std::span<const Shape> {}) == 0.0);
+
+    SECTION("spans of each shape type")
+    {
+        std::vector<Circle> circles = {Circle {1}, Circle {2}};
+        std::vector<Rectangle> rectangles = {Rectangle {2, 3}, Rectangle {-1, 4}};
+        std::vector<Square> squares = {Square {5}};
+
+        REQUIRE(total_area(circles) == 3.14 * 1 * 1 + 3.14 * 2 * 2);
+        REQUIRE(total_area(rectangles) == 2.0);
+        REQUIRE(total_area(squares) == 25.0);
+
+        std::vector<Rectangle> many_rectangles;
+        for (int i = 0; i < 1'000; ++i)
+            many_rectangles.push_back(Rectangle {i, i % 7 - 3});
+
+        int64_t expected {};
+        for (const auto& rect : many_rectangles)
+            expected += int64_t {rect.width} * rect.height;
+        REQUIRE(total_area(many_rectangles) == expected);
+    }
+
+    SECTION("same result as std::visit for many shapes")
+    {
+        std::mt19937_64 rnd {665};
+        std::vector<Shape> many_shapes;
+        for (size_t i = 0; i < 10'000; ++i)
+        {
+            const int size = static_cast<int>(rnd() % 100);
+            const auto kind = rnd() % 3;
+            many_shapes.push_back(kind == 0 ? Shape {Circle {size}} : kind == 1 ? Shape {Rectangle {size, size + 1}} : Shape {Square {size}});
+        }
+
+        double expected {};
+        for (const auto& shape : many_shapes)
+            expected += std::visit(overloaded(
+                [](const Circle& circ) -> double { return 3.14 * circ.radius * circ.radius; },
+                [](const Rectangle& rect) -> double { return rect.width * rect.height; },
+                [](const Square& square) -> double { return square.size * square.size; }), shape);
+
+        REQUIRE(total_area(many_shapes) == Approx(expected).epsilon(1e-12));
+    }
+}
+
+// total area & its error against a reference sum - result of the benchmark below
+struct MeasuredArea
+{
+    double value;
+    long double reference;
+
+    friend std::ostream& operator<<(std::ostream& out, const MeasuredArea& area)
+    {
+        return out << area.value << " total area, error " << static_cast<double>(std::abs(area.value - area.reference));
+    }
+};
+
+TEST_CASE("std::visit vs. SIMD area kernels", "[.][benchmark]")
+{
+    constexpr size_t count = 10'000'000;
+
+    std::mt19937_64 rnd {665};
+    std::vector<Shape> shapes;
+    std::vector<Circle> circles;
+    shapes.reserve(count);
+    circles.reserve(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const int size = static_cast<int>(rnd() % 10'000);
+        switch (rnd() % 3)
+        {
+            case 0: shapes.push_back(Circle {size}); break;
+            case 1: shapes.push_back(Rectangle {size, size + 1}); break;
+            default: shapes.push_back(Square {size}); break;
+        }
+        circles.push_back(Circle {size});
+    }
+
+    const auto area = overloaded(
+        [](const Circle& circ) -> double { return 3.14 * circ.radius * circ.radius; },
+        [](const Rectangle& rect) -> double { return rect.width * rect.height; },
+        [](const Square& square) -> double { return square.size * square.size; }
+    );
+
+    // terms are the same doubles - only the summation is more precise
+    long double shapes_reference {};
+    for (const auto& shape : shapes)
+        shapes_reference += std::visit(area, shape);
+
+    long double circles_reference {};
+    for (const auto& circ : circles)
+        circles_reference += area(circ);
+
+    Benchmark::measure("std::vector<Shape> + std::visit  ", [&] {
+        double total_area {};
+        for (const auto& shape : shapes)
+            total_area += std::visit(area, shape);
+        return MeasuredArea {total_area, shapes_reference};
+    });
+
+    Benchmark::measure("total_area(std::span<const Shape>)", [&] { return MeasuredArea {total_area(shapes), shapes_reference}; });
+
+    Benchmark::measure("circles - scalar loop            ", [&] {
+        double total_area {};
+        for (const auto& circ : circles)
+            total_area += 3.14 * circ.radius * circ.radius;
+        return MeasuredArea {total_area, circles_reference};
+    });
+
+    Benchmark::measure("total_area(std::span<const Circle>)", [&] { return MeasuredArea {total_area(circles), circles_reference}; });
+}
+
 ///////////////////////////////////////////////////////////
 // variant as value||error handler
 
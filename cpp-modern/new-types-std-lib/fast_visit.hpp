@@ -0,0 +1,154 @@
+#ifndef FAST_VISIT_HPP
+#define FAST_VISIT_HPP
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// fast_visit(visitor, variants...) - drop-in replacement of std::visit
+// - one flat table of function pointers for all combinations of alternatives (generated with index_sequence)
+//   flat index = (...(index_0 * size_1 + index_1) * size_2 + index_2 ...) - O(1) dispatch for any number of variants
+// - small tables (up to 32 entries) are dispatched with a switch - a compiler can inline the visitor
+// - like std::visit - the visitor must return the same type for all combinations of alternatives
+// - throws std::bad_variant_access if any variant is valueless_by_exception
+
+namespace FastVisit
+{
+    namespace Details
+    {
+        template <typename TVariant>
+        constexpr size_t variant_size = std::variant_size_v<std::remove_cvref_t<TVariant>>;
+
+        template <typename... TVariants>
+        constexpr size_t table_size = (variant_size<TVariants> * ... * 1);
+
+        template <typename TVisitor, typename... TVariants>
+        using result_t = std::invoke_result_t<TVisitor, decltype(std::get<0>(std::declval<TVariants>()))...>;
+
+        template <size_t Flat, typename... TVariants>
+        constexpr std::array<size_t, sizeof...(TVariants)> unflatten()
+        {
+            constexpr std::array<size_t, sizeof...(TVariants)> sizes{variant_size<TVariants>...};
+
+            std::array<size_t, sizeof...(TVariants)> indexes{};
+            size_t flat = Flat;
+            for (size_t i = sizes.size(); i-- > 0;)
+            {
+                indexes[i] = flat % sizes[i];
+                flat /= sizes[i];
+            }
+            return indexes;
+        }
+
+        // the index is already checked by fast_visit - lets a compiler drop the check in std::get
+        template <size_t I, typename TVariant>
+        decltype(auto) get_unchecked(TVariant&& variant)
+        {
+#if defined(__GNUC__)
+            if (variant.index() != I)
+                __builtin_unreachable();
+#elif defined(_MSC_VER)
+            __assume(variant.index() == I);
+#endif
+            return std::get<I>(std::forward<TVariant>(variant));
+        }
+
+        template <size_t Flat, typename TVisitor, typename... TVariants, size_t... Vs>
+        auto result_at(std::index_sequence<Vs...>)
+            -> std::invoke_result_t<TVisitor, decltype(std::get<unflatten<Flat, TVariants...>()[Vs]>(std::declval<TVariants>()))...>;
+
+        // std::visit requires the same type & value category for all combinations of alternatives
+        template <typename TVisitor, typename... TVariants, size_t... Flats>
+        constexpr bool has_same_results(std::index_sequence<Flats...>)
+        {
+            return (std::is_same_v<decltype(result_at<Flats, TVisitor, TVariants...>(std::index_sequence_for<TVariants...>{})),
+                        result_t<TVisitor, TVariants...>> && ...);
+        }
+
+        template <typename TVisitor, typename... TVariants>
+        constexpr bool has_same_results_v = has_same_results<TVisitor, TVariants...>(std::make_index_sequence<table_size<TVariants...>>{});
+
+        template <size_t Flat, typename TVisitor, typename... TVariants, size_t... Vs>
+        result_t<TVisitor, TVariants...> invoke_at(std::index_sequence<Vs...>, TVisitor&& visitor, TVariants&&... variants)
+        {
+            constexpr auto indexes = unflatten<Flat, TVariants...>();
+            return std::invoke(std::forward<TVisitor>(visitor), get_unchecked<indexes[Vs]>(std::forward<TVariants>(variants))...);
+        }
+
+        template <size_t Flat, typename TVisitor, typename... TVariants>
+        result_t<TVisitor, TVariants...> invoke(TVisitor&& visitor, TVariants&&... variants)
+        {
+            return invoke_at<Flat>(std::index_sequence_for<TVariants...>{}, std::forward<TVisitor>(visitor), std::forward<TVariants>(variants)...);
+        }
+
+        template <typename TVisitor, typename... TVariants, size_t... Flats>
+        constexpr auto make_table(std::index_sequence<Flats...>)
+        {
+            using Dispatcher = result_t<TVisitor, TVariants...> (*)(TVisitor&&, TVariants&&...);
+            return std::array<Dispatcher, sizeof...(Flats)>{&invoke<Flats, TVisitor, TVariants...>...};
+        }
+
+        template <typename TVisitor, typename... TVariants>
+        constexpr auto table = make_table<TVisitor, TVariants...>(std::make_index_sequence<table_size<TVariants...>>{});
+
+        constexpr size_t max_switch_size = 32;
+
+#define FAST_VISIT_CASE(n)                                                                                          \
+    case n:                                                                                                         \
+        if constexpr (n < table_size<TVariants...>)                                                                 \
+            return invoke<n>(std::forward<TVisitor>(visitor), std::forward<TVariants>(variants)...);                \
+        [[fallthrough]];
+
+        template <typename TVisitor, typename... TVariants>
+        result_t<TVisitor, TVariants...> switch_dispatch(size_t flat, TVisitor&& visitor, TVariants&&... variants)
+        {
+            static_assert(table_size<TVariants...> <= max_switch_size);
+
+            switch (flat)
+            {
+                FAST_VISIT_CASE(0) FAST_VISIT_CASE(1) FAST_VISIT_CASE(2) FAST_VISIT_CASE(3)
+                FAST_VISIT_CASE(4) FAST_VISIT_CASE(5) FAST_VISIT_CASE(6) FAST_VISIT_CASE(7)
+                FAST_VISIT_CASE(8) FAST_VISIT_CASE(9) FAST_VISIT_CASE(10) FAST_VISIT_CASE(11)
+                FAST_VISIT_CASE(12) FAST_VISIT_CASE(13) FAST_VISIT_CASE(14) FAST_VISIT_CASE(15)
+                FAST_VISIT_CASE(16) FAST_VISIT_CASE(17) FAST_VISIT_CASE(18) FAST_VISIT_CASE(19)
+                FAST_VISIT_CASE(20) FAST_VISIT_CASE(21) FAST_VISIT_CASE(22) FAST_VISIT_CASE(23)
+                FAST_VISIT_CASE(24) FAST_VISIT_CASE(25) FAST_VISIT_CASE(26) FAST_VISIT_CASE(27)
+                FAST_VISIT_CASE(28) FAST_VISIT_CASE(29) FAST_VISIT_CASE(30) FAST_VISIT_CASE(31)
+            default:
+                break;
+            }
+
+#if defined(__GNUC__)
+            __builtin_unreachable();
+#elif defined(_MSC_VER)
+            __assume(false);
+#endif
+        }
+
+#undef FAST_VISIT_CASE
+    }
+
+    template <typename TVisitor, typename... TVariants>
+    decltype(auto) fast_visit(TVisitor&& visitor, TVariants&&... variants)
+    {
+        static_assert(Details::has_same_results_v<TVisitor, TVariants...>,
+            "fast_visit requires the visitor to return the same type for all alternatives");
+
+        if ((variants.valueless_by_exception() || ...))
+            throw std::bad_variant_access{};
+
+        size_t flat = 0;
+        ((flat = flat * Details::variant_size<TVariants> + variants.index()), ...);
+
+        if constexpr (Details::table_size<TVariants...> <= Details::max_switch_size)
+            return Details::switch_dispatch(flat, std::forward<TVisitor>(visitor), std::forward<TVariants>(variants)...);
+        else
+            return Details::table<TVisitor, TVariants...>[flat](std::forward<TVisitor>(visitor), std::forward<TVariants>(variants)...);
+    }
+}
+
+#endif
@@ -0,0 +1,348 @@
+#ifndef FLOAT_PARSER_HPP
+#define FLOAT_PARSER_HPP
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+#include "int_parser.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// parsing of doubles - the same acceptance rules as std::from_chars (chars_format::general)
+// - decimal mantissa & exponent are parsed with SWAR (8 digits at a time)
+// - fast path (Clinger): mantissa <= 2^53 and |exponent| <= 22 - one exact multiplication or division
+// - Eisel-Lemire: mantissa * 5^q as a 128-bit product with a table of powers of five computed at compile time
+// - hard cases (more than 19 significant digits, overflow, underflow, inf, nan) fall back to std::from_chars
+// - columns of doubles are parsed like columns of ints - see IntParser
+
+namespace FloatParser
+{
+    namespace Details
+    {
+        constexpr int smallest_power_of_ten = -342;
+        constexpr int largest_power_of_ten = 308;
+        constexpr int mantissa_explicit_bits = 52;
+        constexpr int minimum_exponent = -1023;
+        constexpr int infinite_power = 0x7FF;
+        constexpr int min_exponent_round_to_even = -4;
+        constexpr int max_exponent_round_to_even = 23;
+
+        struct UInt128
+        {
+            uint64_t high;
+            uint64_t low;
+        };
+
+        // big integer used to compute the table - 1024 bits, little endian 32-bit words
+        class BigInt
+        {
+            std::array<uint32_t, 32> words_{};
+
+        public:
+            constexpr explicit BigInt(uint32_t value)
+            {
+                words_[0] = value;
+            }
+
+            constexpr void set_bit(int index)
+            {
+                words_[index / 32] |= uint32_t{1} << (index % 32);
+            }
+
+            constexpr bool bit(int index) const
+            {
+                return index >= 0 && (words_[index / 32] >> (index % 32)) & 1;
+            }
+
+            constexpr int bit_width() const
+            {
+                for (int i = words_.size() - 1; i >= 0; --i)
+                    if (words_[i] != 0)
+                        return 32 * i + std::bit_width(words_[i]);
+                return 0;
+            }
+
+            constexpr void multiply(uint32_t factor)
+            {
+                uint64_t carry = 0;
+                for (auto& word : words_)
+                {
+                    carry += uint64_t{word} * factor;
+                    word = static_cast<uint32_t>(carry);
+                    carry >>= 32;
+                }
+            }
+
+            constexpr void divide(uint32_t divisor)
+            {
+                uint64_t remainder = 0;
+                for (int i = words_.size() - 1; i >= 0; --i)
+                {
+                    const uint64_t current = (remainder << 32) | words_[i];
+                    words_[i] = static_cast<uint32_t>(current / divisor);
+                    remainder = current % divisor;
+                }
+            }
+
+            // 128 most significant bits (the highest bit set)
+            constexpr UInt128 leading_bits() const
+            {
+                const int first = bit_width() - 128;
+
+                UInt128 result{};
+                for (int i = 0; i < 64; ++i)
+                {
+                    result.low |= uint64_t{bit(first + i)} << i;
+                    result.high |= uint64_t{bit(first + 64 + i)} << i;
+                }
+                return result;
+            }
+        };
+
+        // 5^q for q in [smallest_power_of_ten, largest_power_of_ten] normalized to 128 bits:
+        // - q >= 0: truncated
+        // - q < 0: 2^1023 / 5^-q - truncated and incremented for q >= -27 (the same table as fast_float)
+        constexpr auto compute_powers_of_five()
+        {
+            std::array<UInt128, largest_power_of_ten - smallest_power_of_ten + 1> powers{};
+
+            BigInt power{1};
+            for (int q = 0; q <= largest_power_of_ten; ++q)
+            {
+                powers[q - smallest_power_of_ten] = power.leading_bits();
+                power.multiply(5);
+            }
+
+            BigInt inverse{0};
+            inverse.set_bit(1023);
+            for (int q = -1; q >= smallest_power_of_ten; --q)
+            {
+                inverse.divide(5);
+                auto bits = inverse.leading_bits();
+                if (q >= -27)
+                    bits.high += ++bits.low == 0;
+                powers[q - smallest_power_of_ten] = bits;
+            }
+
+            return powers;
+        }
+
+        inline constexpr auto powers_of_five = compute_powers_of_five();
+
+        inline UInt128 full_multiplication(uint64_t a, uint64_t b)
+        {
+#ifdef __SIZEOF_INT128__
+            const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+            return {static_cast<uint64_t>(product >> 64), static_cast<uint64_t>(product)};
+#else
+            const uint64_t a_low = static_cast<uint32_t>(a), a_high = a >> 32;
+            const uint64_t b_low = static_cast<uint32_t>(b), b_high = b >> 32;
+
+            const uint64_t low_low = a_low * b_low;
+            const uint64_t high_low = a_high * b_low;
+            const uint64_t low_high = a_low * b_high;
+            const uint64_t high_high = a_high * b_high;
+
+            const uint64_t middle = (low_low >> 32) + static_cast<uint32_t>(high_low) + static_cast<uint32_t>(low_high);
+            return {high_high + (high_low >> 32) + (low_high >> 32) + (middle >> 32), (middle << 32) | static_cast<uint32_t>(low_low)};
+#endif
+        }
+
+        // binary exponent of 10^q: floor(q * log2(10)) + 63
+        constexpr int power(int q)
+        {
+            return (((152170 + 65536) * q) >> 16) + 63;
+        }
+
+        // D. Lemire - "Number Parsing at a Gigabyte per Second"
+        // returns false if the result is not a finite, nonzero double (handled by the fallback)
+        inline bool eisel_lemire(uint64_t w, int q, bool is_negative, double& value)
+        {
+            if (q < smallest_power_of_ten || q > largest_power_of_ten)
+                return false;
+
+            const int leading_zeros = std::countl_zero(w);
+            w <<= leading_zeros;
+
+            // product of w and 5^q - the second multiplication only when the truncated bits may matter
+            const UInt128& power_of_five = powers_of_five[q - smallest_power_of_ten];
+            UInt128 product = full_multiplication(w, power_of_five.high);
+
+            constexpr uint64_t precision_mask = ~uint64_t{0} >> (mantissa_explicit_bits + 3);
+            if ((product.high & precision_mask) == precision_mask)
+            {
+                const UInt128 second_product = full_multiplication(w, power_of_five.low);
+                product.low += second_product.high;
+                product.high += second_product.high > product.low;
+            }
+
+            const int upper_bit = static_cast<int>(product.high >> 63);
+            const int shift = upper_bit + 64 - mantissa_explicit_bits - 3;
+
+            uint64_t mantissa = product.high >> shift;
+            int power2 = power(q) + upper_bit - leading_zeros - minimum_exponent;
+
+            if (power2 <= 0) // subnormal or zero
+                return false;
+
+            // exactly between two doubles - round to even
+            if (product.low <= 1 && q >= min_exponent_round_to_even && q <= max_exponent_round_to_even && (mantissa & 3) == 1
+                && (mantissa << shift) == product.high)
+                mantissa &= ~uint64_t{1};
+
+            mantissa += mantissa & 1;
+            mantissa >>= 1;
+
+            if (mantissa >= (uint64_t{2} << mantissa_explicit_bits))
+            {
+                mantissa = uint64_t{1} << mantissa_explicit_bits;
+                ++power2;
+            }
+
+            mantissa &= ~(uint64_t{1} << mantissa_explicit_bits);
+
+            if (power2 >= infinite_power)
+                return false;
+
+            const uint64_t bits = mantissa | static_cast<uint64_t>(power2) << mantissa_explicit_bits | uint64_t{is_negative} << 63;
+            value = std::bit_cast<double>(bits);
+            return true;
+        }
+
+        inline bool is_digit(char c)
+        {
+            return static_cast<unsigned char>(c - '0') <= 9;
+        }
+
+        inline const char* parse_digits(const char* first, const char* last, uint64_t& w)
+        {
+            while (last - first >= 8)
+            {
+                const uint64_t chunk = IntParser::Details::load8(first);
+                if (!IntParser::Details::are_eight_digits(chunk))
+                    break;
+
+                w = w * 100'000'000 + IntParser::Details::parse_eight_digits(chunk);
+                first += 8;
+            }
+
+            for (; first != last && is_digit(*first); ++first)
+                w = w * 10 + (*first - '0');
+
+            return first;
+        }
+
+        inline bool from_chars_fallback(const char* first, const char* last, double& value)
+        {
+            const auto [end, error_code] = std::from_chars(first, last, value);
+            return error_code == std::errc{} && end == last;
+        }
+
+        inline constexpr std::array<double, 23> exact_powers_of_ten = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+        // true if [first, last) is exactly one number
+        inline bool parse_field(const char* first, const char* last, double& value)
+        {
+            const char* const number_first = first;
+
+            const bool is_negative = first != last && *first == '-';
+            if (is_negative)
+                ++first;
+
+            uint64_t w = 0;
+
+            const char* const integer_first = first;
+            first = parse_digits(first, last, w);
+            int64_t digits_count = first - integer_first;
+
+            int64_t exponent = 0;
+            if (first != last && *first == '.')
+            {
+                const char* const fraction_first = ++first;
+                first = parse_digits(first, last, w);
+                exponent = fraction_first - first;
+                digits_count += first - fraction_first;
+            }
+
+            if (digits_count == 0) // inf, nan or an error
+                return from_chars_fallback(number_first, last, value);
+
+            if (first != last && (*first == 'e' || *first == 'E'))
+            {
+                ++first;
+
+                const bool is_negative_exponent = first != last && *first == '-';
+                if (first != last && (*first == '-' || *first == '+'))
+                    ++first;
+
+                if (first == last)
+                    return false;
+
+                int64_t explicit_exponent = 0;
+                for (; first != last && is_digit(*first); ++first)
+                    if (explicit_exponent < 0x10000)
+                        explicit_exponent = explicit_exponent * 10 + (*first - '0');
+
+                exponent += is_negative_exponent ? -explicit_exponent : explicit_exponent;
+            }
+
+            if (first != last)
+                return false;
+
+            if (digits_count > 19) // w may overflow - leading zeros are not significant
+            {
+                for (const char* digit = integer_first; digit != last && (*digit == '0' || *digit == '.'); ++digit)
+                    digits_count -= *digit == '0';
+
+                if (digits_count > 19)
+                    return from_chars_fallback(number_first, last, value);
+            }
+
+            if (w == 0)
+            {
+                value = is_negative ? -0.0 : 0.0;
+                return true;
+            }
+
+            if (exponent >= -22 && exponent <= 22 && w <= (uint64_t{1} << 53))
+            {
+                value = static_cast<double>(w);
+                value = exponent < 0 ? value / exact_powers_of_ten[-exponent] : value * exact_powers_of_ten[exponent];
+                if (is_negative)
+                    value = -value;
+                return true;
+            }
+
+            if (eisel_lemire(w, static_cast<int>(exponent), is_negative, value))
+                return true;
+
+            return from_chars_fallback(number_first, last, value);
+        }
+    }
+
+    inline bool parse_double(std::string_view text, double& value)
+    {
+        return Details::parse_field(text.data(), text.data() + text.size(), value);
+    }
+
+    // returns number of fields in buffer - values beyond out.size() are not stored
+    // errors must be zero initialized
+    inline size_t parse_doubles(std::string_view buffer, std::span<double> out, std::span<uint64_t> errors)
+    {
+        return IntParser::Details::parse_column(buffer, out, errors, Details::parse_field);
+    }
+
+    inline size_t parse_doubles_parallel(std::string_view buffer, std::span<double> out, std::span<uint64_t> errors,
+        size_t thread_count = IntParser::default_thread_count())
+    {
+        return IntParser::Details::parse_column_parallel(buffer, out, errors, thread_count, Details::parse_field);
+    }
+}
+
+#endif
@@ -0,0 +1,289 @@
+#ifndef INLINE_ANY_HPP
+#define INLINE_ANY_HPP
+
+#include <algorithm>
+#include <any>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// inline_any<Size, Align> - std::any with a configurable inline buffer and without RTTI
+// - values up to Size bytes (alignment <= Align, nothrow movable) are stored inline - no heap allocation
+// - larger values are allocated on the heap (like std::any) - the buffer is aligned at least for the pointer
+// - stored types are decayed (emplace<const X> stores X - like std::any)
+// - a type is identified by the address of a per-type static tag - any_cast compares two pointers instead of typeid
+// - bad casts throw std::bad_any_cast (the same contract as std::any_cast)
+
+namespace InlineAny
+{
+    namespace Details
+    {
+        template <typename T>
+        struct TypeTag
+        {
+            static inline char id{}; // not const - identical constants may be merged by a linker
+        };
+
+        template <typename T>
+        constexpr bool is_in_place_type_v = false;
+
+        template <typename T>
+        constexpr bool is_in_place_type_v<std::in_place_type_t<T>> = true;
+
+        template <typename T>
+        constexpr const void* type_id()
+        {
+            return &TypeTag<T>::id;
+        }
+
+        struct VTable
+        {
+            const void* type;
+            void (*destroy)(void* storage) noexcept;
+            void (*copy)(void* dest, const void* src);
+            void (*move)(void* dest, void* src) noexcept; // src is left empty
+        };
+
+        template <typename T, bool IsInline>
+        struct Handler
+        {
+            static T* get(void* storage) noexcept
+            {
+                if constexpr (IsInline)
+                    return std::launder(static_cast<T*>(storage));
+                else
+                    return *static_cast<T**>(storage);
+            }
+
+            static const T* get(const void* storage) noexcept
+            {
+                return get(const_cast<void*>(storage));
+            }
+
+            template <typename... TArgs>
+            static T* create(void* storage, TArgs&&... args)
+            {
+                if constexpr (IsInline)
+                    return ::new (storage) T(std::forward<TArgs>(args)...);
+                else
+                    return *static_cast<T**>(storage) = new T(std::forward<TArgs>(args)...);
+            }
+
+            static void destroy(void* storage) noexcept
+            {
+                if constexpr (IsInline)
+                    get(storage)->~T();
+                else
+                    delete get(storage);
+            }
+
+            static void copy(void* dest, const void* src)
+            {
+                create(dest, *get(src));
+            }
+
+            static void move(void* dest, void* src) noexcept
+            {
+                if constexpr (IsInline)
+                {
+                    create(dest, std::move(*get(src)));
+                    destroy(src);
+                }
+                else
+                    *static_cast<T**>(dest) = get(src);
+            }
+
+            static constexpr VTable vtable{type_id<T>(), &destroy, &copy, &move};
+        };
+    }
+
+    template <size_t Size = 32, size_t Align = alignof(std::max_align_t)>
+    class inline_any
+    {
+        static_assert(Size >= sizeof(void*), "inline buffer must be able to store a pointer");
+
+        static constexpr size_t storage_align = std::max(Align, alignof(void*)); // a heap value is stored as a pointer
+
+        const Details::VTable* vtable_ = nullptr;
+        alignas(storage_align) std::byte storage_[Size];
+
+        template <typename T, size_t S, size_t A>
+        friend const T* any_cast(const inline_any<S, A>* any) noexcept;
+
+    public:
+        template <typename T>
+        static constexpr bool is_stored_inline()
+        {
+            return sizeof(T) <= Size && alignof(T) <= storage_align && std::is_nothrow_move_constructible_v<T>;
+        }
+
+    private:
+        template <typename T>
+        using HandlerFor = Details::Handler<T, is_stored_inline<T>()>;
+
+    public:
+        inline_any() noexcept = default;
+
+        template <typename T, typename TValue = std::decay_t<T>>
+            requires(!std::is_same_v<TValue, inline_any>) && (!Details::is_in_place_type_v<TValue>) && std::is_copy_constructible_v<TValue>
+        inline_any(T&& value)
+        {
+            emplace<TValue>(std::forward<T>(value));
+        }
+
+        template <typename T, typename... TArgs>
+        explicit inline_any(std::in_place_type_t<T>, TArgs&&... args)
+        {
+            emplace<T>(std::forward<TArgs>(args)...);
+        }
+
+        inline_any(const inline_any& other)
+        {
+            if (other.vtable_)
+            {
+                other.vtable_->copy(storage_, other.storage_);
+                vtable_ = other.vtable_;
+            }
+        }
+
+        inline_any(inline_any&& other) noexcept
+        {
+            if (other.vtable_)
+            {
+                other.vtable_->move(storage_, other.storage_);
+                vtable_ = std::exchange(other.vtable_, nullptr);
+            }
+        }
+
+        inline_any& operator=(const inline_any& other)
+        {
+            inline_any(other).swap(*this);
+            return *this;
+        }
+
+        inline_any& operator=(inline_any&& other) noexcept
+        {
+            inline_any(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        template <typename T, typename TValue = std::decay_t<T>>
+            requires(!std::is_same_v<TValue, inline_any>) && std::is_copy_constructible_v<TValue>
+        inline_any& operator=(T&& value)
+        {
+            emplace<TValue>(std::forward<T>(value));
+            return *this;
+        }
+
+        ~inline_any()
+        {
+            reset();
+        }
+
+        template <typename T, typename... TArgs, typename TValue = std::decay_t<T>>
+        TValue& emplace(TArgs&&... args)
+        {
+            reset();
+
+            TValue* value = HandlerFor<TValue>::create(storage_, std::forward<TArgs>(args)...);
+            vtable_ = &HandlerFor<TValue>::vtable;
+            return *value;
+        }
+
+        void reset() noexcept
+        {
+            if (vtable_)
+                std::exchange(vtable_, nullptr)->destroy(storage_);
+        }
+
+        void swap(inline_any& other) noexcept
+        {
+            if (this == &other)
+                return;
+
+            inline_any temp;
+            if (other.vtable_)
+            {
+                other.vtable_->move(temp.storage_, other.storage_);
+                temp.vtable_ = std::exchange(other.vtable_, nullptr);
+            }
+
+            if (vtable_)
+            {
+                vtable_->move(other.storage_, storage_);
+                other.vtable_ = std::exchange(vtable_, nullptr);
+            }
+
+            if (temp.vtable_)
+            {
+                temp.vtable_->move(storage_, temp.storage_);
+                vtable_ = std::exchange(temp.vtable_, nullptr);
+            }
+        }
+
+        bool has_value() const noexcept
+        {
+            return vtable_ != nullptr;
+        }
+
+        template <typename T>
+        bool is() const noexcept
+        {
+            return vtable_ && vtable_->type == Details::type_id<T>();
+        }
+    };
+
+    template <typename T, size_t Size, size_t Align>
+    const T* any_cast(const inline_any<Size, Align>* any) noexcept
+    {
+        using TValue = std::remove_cv_t<T>; // cv-qualifiers are ignored - like std::any_cast
+
+        if (!any || !any->template is<TValue>())
+            return nullptr;
+
+        return inline_any<Size, Align>::template HandlerFor<TValue>::get(any->storage_);
+    }
+
+    template <typename T, size_t Size, size_t Align>
+    T* any_cast(inline_any<Size, Align>* any) noexcept
+    {
+        return const_cast<T*>(any_cast<T>(static_cast<const inline_any<Size, Align>*>(any)));
+    }
+
+    template <typename T, size_t Size, size_t Align>
+    T any_cast(const inline_any<Size, Align>& any)
+    {
+        using TValue = std::remove_cvref_t<T>;
+
+        if (const TValue* value = any_cast<TValue>(&any))
+            return static_cast<T>(*value);
+
+        throw std::bad_any_cast{};
+    }
+
+    template <typename T, size_t Size, size_t Align>
+    T any_cast(inline_any<Size, Align>& any)
+    {
+        using TValue = std::remove_cvref_t<T>;
+
+        if (TValue* value = any_cast<TValue>(&any))
+            return static_cast<T>(*value);
+
+        throw std::bad_any_cast{};
+    }
+
+    template <typename T, size_t Size, size_t Align>
+    T any_cast(inline_any<Size, Align>&& any)
+    {
+        using TValue = std::remove_cvref_t<T>;
+
+        if (TValue* value = any_cast<TValue>(&any))
+            return static_cast<T>(std::move(*value));
+
+        throw std::bad_any_cast{};
+    }
+}
+
+#endif
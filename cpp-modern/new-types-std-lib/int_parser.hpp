@@ -0,0 +1,214 @@
+#ifndef INT_PARSER_HPP
+#define INT_PARSER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// bulk parsing of delimiter-separated integers (CSV columns)
+// - fields are separated by ',' or '\n' - a delimiter at the end of a buffer doesn't start a new field
+// - a field is valid with the same rules as to_int (std::from_chars): optional '-', digits, in range of int
+// - digits are validated and converted 8 at a time with SWAR (SIMD within a register)
+// - invalid fields are reported in a side bitmap (bit i of errors - field i) and stored as 0
+
+namespace IntParser
+{
+    namespace Details
+    {
+        inline bool is_delimiter(char c)
+        {
+            return c == ',' || c == '\n';
+        }
+
+        inline uint64_t load8(const char* data)
+        {
+            uint64_t chunk;
+            std::memcpy(&chunk, data, 8);
+            return chunk; // little endian assumed - digit i in byte i
+        }
+
+        inline bool are_eight_digits(uint64_t chunk)
+        {
+            return ((chunk & 0xF0F0F0F0F0F0F0F0) | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))
+                == 0x3333333333333333;
+        }
+
+        // D. Lemire - "Quickly parsing eight digits"
+        inline uint32_t parse_eight_digits(uint64_t chunk)
+        {
+            chunk -= 0x3030303030303030;
+            chunk = (chunk * 10) + (chunk >> 8);
+            chunk = (((chunk & 0x000000FF000000FF) * (100 + (1000000ULL << 32)))
+                        + (((chunk >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32))))
+                >> 32;
+            return static_cast<uint32_t>(chunk);
+        }
+
+        inline bool parse_field(const char* first, const char* last, int& value)
+        {
+            const bool is_negative = first != last && *first == '-';
+            if (is_negative)
+                ++first;
+
+            while (last - first > 1 && *first == '0') // leading zeros are accepted by from_chars
+                ++first;
+
+            const size_t digits = last - first;
+            if (digits == 0 || digits > 10)
+                return false;
+
+            uint64_t result = 0;
+
+            if (digits >= 8)
+            {
+                const uint64_t chunk = load8(first);
+                if (!are_eight_digits(chunk))
+                    return false;
+
+                result = parse_eight_digits(chunk);
+                first += 8;
+            }
+
+            for (; first != last; ++first)
+            {
+                const unsigned digit = static_cast<unsigned char>(*first) - '0';
+                if (digit > 9)
+                    return false;
+                result = result * 10 + digit;
+            }
+
+            if (result > (is_negative ? 2147483648ULL : 2147483647ULL))
+                return false;
+
+            value = is_negative ? static_cast<int>(-static_cast<int64_t>(result)) : static_cast<int>(result);
+            return true;
+        }
+
+        inline void set_error(std::span<uint64_t> errors, size_t index)
+        {
+            if (index / 64 < errors.size())
+                std::atomic_ref<uint64_t>{errors[index / 64]}.fetch_or(uint64_t{1} << (index % 64), std::memory_order_relaxed);
+        }
+
+        // parses fields of [first, last) - fields are stored starting from out[first_index]
+        template <typename T, typename TParseField>
+        size_t parse_chunk(const char* first, const char* last, std::span<T> out, std::span<uint64_t> errors,
+            size_t first_index, TParseField parse_field)
+        {
+            size_t index = first_index;
+
+            while (first != last)
+            {
+                const char* field_end = std::find_if(first, last, is_delimiter);
+
+                if (index < out.size())
+                {
+                    T value{};
+                    if (!parse_field(first, field_end, value))
+                    {
+                        set_error(errors, index);
+                        value = T{};
+                    }
+                    out[index] = value;
+                }
+
+                ++index;
+                first = field_end == last ? last : field_end + 1;
+            }
+
+            return index - first_index;
+        }
+    }
+
+    inline size_t count_fields(std::string_view buffer)
+    {
+        if (buffer.empty())
+            return 0;
+
+        return std::count_if(buffer.begin(), buffer.end(), Details::is_delimiter)
+            + !Details::is_delimiter(buffer.back());
+    }
+
+    // words of the error bitmap needed for count fields
+    constexpr size_t error_bitmap_size(size_t count)
+    {
+        return (count + 63) / 64;
+    }
+
+    namespace Details
+    {
+        template <typename T, typename TParseField>
+        size_t parse_column(std::string_view buffer, std::span<T> out, std::span<uint64_t> errors, TParseField parse_field)
+        {
+            return parse_chunk(buffer.data(), buffer.data() + buffer.size(), out, errors, 0, parse_field);
+        }
+
+        // buffer is split into chunks ending with a delimiter - fields are counted and then parsed in parallel
+        template <typename T, typename TParseField>
+        size_t parse_column_parallel(std::string_view buffer, std::span<T> out, std::span<uint64_t> errors,
+            size_t thread_count, TParseField parse_field)
+        {
+            if (thread_count <= 1)
+                return parse_column(buffer, out, errors, parse_field);
+
+            std::vector<std::string_view> chunks;
+
+            for (size_t chunk_begin = 0; chunk_begin < buffer.size();)
+            {
+                size_t chunk_end = std::min(buffer.size(), chunk_begin + buffer.size() / thread_count + 1);
+                while (chunk_end < buffer.size() && !is_delimiter(buffer[chunk_end - 1]))
+                    ++chunk_end;
+
+                chunks.push_back(buffer.substr(chunk_begin, chunk_end - chunk_begin));
+                chunk_begin = chunk_end;
+            }
+
+            std::vector<size_t> first_indexes(chunks.size() + 1, 0);
+
+            {
+                std::vector<std::jthread> counters;
+                for (size_t i = 0; i < chunks.size(); ++i)
+                    counters.emplace_back([&, i] { first_indexes[i + 1] = count_fields(chunks[i]); });
+            }
+
+            for (size_t i = 1; i < first_indexes.size(); ++i)
+                first_indexes[i] += first_indexes[i - 1];
+
+            {
+                std::vector<std::jthread> parsers;
+                for (size_t i = 0; i < chunks.size(); ++i)
+                    parsers.emplace_back([&, i] {
+                        parse_chunk(chunks[i].data(), chunks[i].data() + chunks[i].size(), out, errors, first_indexes[i], parse_field);
+                    });
+            }
+
+            return first_indexes.back();
+        }
+    }
+
+    inline size_t default_thread_count()
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // returns number of fields in buffer - values beyond out.size() are not stored
+    // errors must be zero initialized
+    inline size_t parse_ints(std::string_view buffer, std::span<int> out, std::span<uint64_t> errors)
+    {
+        return Details::parse_column(buffer, out, errors, Details::parse_field);
+    }
+
+    inline size_t parse_ints_parallel(std::string_view buffer, std::span<int> out, std::span<uint64_t> errors,
+        size_t thread_count = default_thread_count())
+    {
+        return Details::parse_column_parallel(buffer, out, errors, thread_count, Details::parse_field);
+    }
+}
+
+#endif
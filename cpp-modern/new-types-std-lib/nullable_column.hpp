@@ -0,0 +1,494 @@
+#ifndef NULLABLE_COLUMN_HPP
+#define NULLABLE_COLUMN_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define NULLABLE_COLUMN_SSE2
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// nullable_column<T> - Arrow-style replacement of std::vector<std::optional<T>>
+// - values are contiguous, validity is a packed bitmap (bit i set - element i has a value)
+// - null elements hold T{} in the value array
+// - column[i] returns a proxy with the std::optional interface (has_value, value_or, reset, ...)
+// - aggregations process 64 elements per bitmap word: all-valid words are summed without masks,
+//   mixed words with SIMD lanes masked by the bitmap bits, all-null words are skipped
+// - min/max of double & int32_t: SSE2 lanes - null lanes are replaced with a value which never wins (+/-inf, INT_MAX/MIN)
+
+namespace NullableColumn
+{
+    namespace Details
+    {
+        template <typename T>
+        using sum_t = std::conditional_t<std::is_floating_point_v<T>, double, std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+
+        template <typename T>
+        sum_t<T> sum_block(const T* values, uint64_t word, size_t count)
+        {
+            sum_t<T> sum{};
+
+            if (count == 64 && word == ~uint64_t{0})
+            {
+                for (size_t i = 0; i < 64; ++i)
+                    sum += values[i];
+            }
+            else
+            {
+                for (; word != 0; word &= word - 1)
+                    sum += values[std::countr_zero(word)];
+            }
+
+            return sum;
+        }
+
+#ifdef NULLABLE_COLUMN_SSE2
+        // lane i is all ones if bit i of bits is set
+        inline __m128d lane_mask_pd(uint64_t bits)
+        {
+            static const __m128d lane_masks[4] = {
+                _mm_castsi128_pd(_mm_set_epi64x(0, 0)),
+                _mm_castsi128_pd(_mm_set_epi64x(0, -1)),
+                _mm_castsi128_pd(_mm_set_epi64x(-1, 0)),
+                _mm_castsi128_pd(_mm_set_epi64x(-1, -1))};
+
+            return lane_masks[bits & 3];
+        }
+
+        inline __m128i lane_mask_epi32(uint64_t bits)
+        {
+            const __m128i bit_selectors = _mm_set_epi32(8, 4, 2, 1);
+            const __m128i lanes = _mm_set1_epi32(static_cast<int>(bits & 15));
+            return _mm_cmpeq_epi32(_mm_and_si128(lanes, bit_selectors), bit_selectors);
+        }
+
+        inline double sum_block(const double* values, uint64_t word, size_t count)
+        {
+            if (count < 64)
+            {
+                double sum = 0.0;
+                for (; word != 0; word &= word - 1)
+                    sum += values[std::countr_zero(word)];
+                return sum;
+            }
+
+            __m128d sum_a = _mm_setzero_pd();
+            __m128d sum_b = _mm_setzero_pd();
+
+            for (size_t i = 0; i < 64; i += 4, word >>= 4)
+            {
+                sum_a = _mm_add_pd(sum_a, _mm_and_pd(_mm_loadu_pd(values + i), lane_mask_pd(word)));
+                sum_b = _mm_add_pd(sum_b, _mm_and_pd(_mm_loadu_pd(values + i + 2), lane_mask_pd(word >> 2)));
+            }
+
+            const __m128d sum = _mm_add_pd(sum_a, sum_b);
+            return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+        }
+
+        inline int64_t sum_block(const int32_t* values, uint64_t word, size_t count)
+        {
+            if (count < 64)
+            {
+                int64_t sum = 0;
+                for (; word != 0; word &= word - 1)
+                    sum += values[std::countr_zero(word)];
+                return sum;
+            }
+
+            __m128i sum_low = _mm_setzero_si128();
+            __m128i sum_high = _mm_setzero_si128();
+
+            for (size_t i = 0; i < 64; i += 4, word >>= 4)
+            {
+                const __m128i masked = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)), lane_mask_epi32(word));
+
+                // sign extension to 64 bits
+                const __m128i signs = _mm_cmpgt_epi32(_mm_setzero_si128(), masked);
+                sum_low = _mm_add_epi64(sum_low, _mm_unpacklo_epi32(masked, signs));
+                sum_high = _mm_add_epi64(sum_high, _mm_unpackhi_epi32(masked, signs));
+            }
+
+            alignas(16) int64_t lanes[2];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_add_epi64(sum_low, sum_high));
+            return lanes[0] + lanes[1];
+        }
+#endif
+
+        // null lanes are replaced with identity() - a value which never wins
+        struct Min
+        {
+            template <typename T>
+            T operator()(T result, T value) const { return std::min(result, value); }
+
+            template <typename T>
+            static constexpr T identity()
+            {
+                return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+            }
+
+#ifdef NULLABLE_COLUMN_SSE2
+            static __m128d apply(__m128d result, __m128d values) { return _mm_min_pd(values, result); } // std::min(result, value)
+
+            static __m128i apply(__m128i result, __m128i values)
+            {
+                const __m128i is_less = _mm_cmplt_epi32(values, result);
+                return _mm_or_si128(_mm_and_si128(is_less, values), _mm_andnot_si128(is_less, result));
+            }
+#endif
+        };
+
+        struct Max
+        {
+            template <typename T>
+            T operator()(T result, T value) const { return std::max(result, value); }
+
+            template <typename T>
+            static constexpr T identity()
+            {
+                return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+            }
+
+#ifdef NULLABLE_COLUMN_SSE2
+            static __m128d apply(__m128d result, __m128d values) { return _mm_max_pd(values, result); } // std::max(result, value)
+
+            static __m128i apply(__m128i result, __m128i values)
+            {
+                const __m128i is_greater = _mm_cmpgt_epi32(values, result);
+                return _mm_or_si128(_mm_and_si128(is_greater, values), _mm_andnot_si128(is_greater, result));
+            }
+#endif
+        };
+
+        // word != 0
+        template <typename TOp, typename T>
+        T reduce_block(const T* values, uint64_t word, size_t count, TOp op)
+        {
+            T result = values[std::countr_zero(word)];
+
+            if (count == 64 && word == ~uint64_t{0})
+            {
+                for (size_t i = 1; i < 64; ++i)
+                    result = op(result, values[i]);
+            }
+            else
+            {
+                for (; word != 0; word &= word - 1)
+                    result = op(result, values[std::countr_zero(word)]);
+            }
+
+            return result;
+        }
+
+#ifdef NULLABLE_COLUMN_SSE2
+        template <typename TOp>
+        double reduce_block(const double* values, uint64_t word, size_t count, TOp op)
+        {
+            if (count < 64)
+            {
+                double result = values[std::countr_zero(word)];
+                for (; word != 0; word &= word - 1)
+                    result = op(result, values[std::countr_zero(word)]);
+                return result;
+            }
+
+            const __m128d identity = _mm_set1_pd(TOp::template identity<double>());
+            __m128d result_a = identity;
+            __m128d result_b = identity;
+
+            for (size_t i = 0; i < 64; i += 4, word >>= 4)
+            {
+                const __m128d mask_a = lane_mask_pd(word);
+                const __m128d mask_b = lane_mask_pd(word >> 2);
+                const __m128d values_a = _mm_or_pd(_mm_and_pd(mask_a, _mm_loadu_pd(values + i)), _mm_andnot_pd(mask_a, identity));
+                const __m128d values_b = _mm_or_pd(_mm_and_pd(mask_b, _mm_loadu_pd(values + i + 2)), _mm_andnot_pd(mask_b, identity));
+                result_a = TOp::apply(result_a, values_a);
+                result_b = TOp::apply(result_b, values_b);
+            }
+
+            const __m128d result = TOp::apply(result_a, result_b);
+            return op(_mm_cvtsd_f64(result), _mm_cvtsd_f64(_mm_unpackhi_pd(result, result)));
+        }
+
+        template <typename TOp>
+        int32_t reduce_block(const int32_t* values, uint64_t word, size_t count, TOp op)
+        {
+            if (count < 64)
+            {
+                int32_t result = values[std::countr_zero(word)];
+                for (; word != 0; word &= word - 1)
+                    result = op(result, values[std::countr_zero(word)]);
+                return result;
+            }
+
+            const __m128i identity = _mm_set1_epi32(TOp::template identity<int32_t>());
+            __m128i result = identity;
+
+            for (size_t i = 0; i < 64; i += 4, word >>= 4)
+            {
+                const __m128i mask = lane_mask_epi32(word);
+                const __m128i lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+                result = TOp::apply(result, _mm_or_si128(_mm_and_si128(mask, lanes), _mm_andnot_si128(mask, identity)));
+            }
+
+            alignas(16) int32_t lanes[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), result);
+            return op(op(lanes[0], lanes[1]), op(lanes[2], lanes[3]));
+        }
+#endif
+    }
+
+    template <typename T>
+    class nullable_column
+    {
+        static_assert(std::is_arithmetic_v<T>, "nullable_column stores numbers");
+
+        std::vector<T> values_;
+        std::vector<uint64_t> validity_;
+
+        bool is_valid(size_t index) const
+        {
+            return (validity_[index / 64] >> (index % 64)) & 1;
+        }
+
+        void set_valid(size_t index, bool is_valid)
+        {
+            const uint64_t bit = uint64_t{1} << (index % 64);
+            validity_[index / 64] = is_valid ? validity_[index / 64] | bit : validity_[index / 64] & ~bit;
+        }
+
+        template <typename TFunction>
+        void for_each_block(TFunction f) const
+        {
+            for (size_t block = 0; block < validity_.size(); ++block)
+                f(values_.data() + 64 * block, validity_[block], std::min<size_t>(64, values_.size() - 64 * block));
+        }
+
+    public:
+        using value_type = T;
+
+        class reference
+        {
+            nullable_column* column_;
+            size_t index_;
+
+        public:
+            reference(nullable_column& column, size_t index)
+                : column_{&column}
+                , index_{index}
+            {
+            }
+
+            bool has_value() const
+            {
+                return column_->is_valid(index_);
+            }
+
+            explicit operator bool() const
+            {
+                return has_value();
+            }
+
+            T operator*() const
+            {
+                return column_->values_[index_];
+            }
+
+            T value() const
+            {
+                if (!has_value())
+                    throw std::bad_optional_access{};
+                return column_->values_[index_];
+            }
+
+            template <typename U>
+            T value_or(U&& default_value) const
+            {
+                return has_value() ? column_->values_[index_] : static_cast<T>(std::forward<U>(default_value));
+            }
+
+            void reset()
+            {
+                column_->values_[index_] = T{};
+                column_->set_valid(index_, false);
+            }
+
+            reference& operator=(const T& value)
+            {
+                column_->values_[index_] = value;
+                column_->set_valid(index_, true);
+                return *this;
+            }
+
+            reference& operator=(std::nullopt_t)
+            {
+                reset();
+                return *this;
+            }
+
+            reference& operator=(const std::optional<T>& value)
+            {
+                return value ? *this = *value : *this = std::nullopt;
+            }
+
+            operator std::optional<T>() const
+            {
+                return has_value() ? std::optional<T>{column_->values_[index_]} : std::nullopt;
+            }
+
+            bool operator==(std::nullopt_t) const
+            {
+                return !has_value();
+            }
+
+            bool operator==(const T& value) const
+            {
+                return has_value() && column_->values_[index_] == value;
+            }
+        };
+
+        nullable_column() = default;
+
+        // all elements are null
+        explicit nullable_column(size_t size)
+            : values_(size)
+            , validity_((size + 63) / 64)
+        {
+        }
+
+        nullable_column(std::initializer_list<std::optional<T>> items)
+        {
+            reserve(items.size());
+            for (const auto& item : items)
+                push_back(item);
+        }
+
+        size_t size() const
+        {
+            return values_.size();
+        }
+
+        bool empty() const
+        {
+            return values_.empty();
+        }
+
+        void reserve(size_t capacity)
+        {
+            values_.reserve(capacity);
+            validity_.reserve((capacity + 63) / 64);
+        }
+
+        void push_back(const T& value)
+        {
+            if (values_.size() % 64 == 0)
+                validity_.push_back(0);
+
+            values_.push_back(value);
+            set_valid(values_.size() - 1, true);
+        }
+
+        void push_back(std::nullopt_t)
+        {
+            if (values_.size() % 64 == 0)
+                validity_.push_back(0);
+
+            values_.push_back(T{});
+        }
+
+        void push_back(const std::optional<T>& item)
+        {
+            item ? push_back(*item) : push_back(std::nullopt);
+        }
+
+        reference operator[](size_t index)
+        {
+            return reference{*this, index};
+        }
+
+        std::optional<T> operator[](size_t index) const
+        {
+            return is_valid(index) ? std::optional<T>{values_[index]} : std::nullopt;
+        }
+
+        std::span<const T> values() const
+        {
+            return values_;
+        }
+
+        std::span<const uint64_t> validity() const
+        {
+            return validity_;
+        }
+
+        size_t count() const
+        {
+            size_t count = 0;
+            for (uint64_t word : validity_)
+                count += std::popcount(word);
+            return count;
+        }
+
+        size_t null_count() const
+        {
+            return size() - count();
+        }
+
+        Details::sum_t<T> sum() const
+        {
+            Details::sum_t<T> sum{};
+            for_each_block([&sum](const T* values, uint64_t word, size_t count) {
+                if (word != 0)
+                    sum += Details::sum_block(values, word, count);
+            });
+            return sum;
+        }
+
+        std::optional<double> mean() const
+        {
+            const size_t valid_count = count();
+            if (valid_count == 0)
+                return std::nullopt;
+            return static_cast<double>(sum()) / valid_count;
+        }
+
+        std::optional<T> min() const
+        {
+            return reduce(Details::Min{});
+        }
+
+        std::optional<T> max() const
+        {
+            return reduce(Details::Max{});
+        }
+
+    private:
+        template <typename TReduce>
+        std::optional<T> reduce(TReduce reduce_op) const
+        {
+            std::optional<T> result;
+
+            for_each_block([&](const T* values, uint64_t word, size_t count) {
+                if (word == 0)
+                    return;
+
+                const T block_result = Details::reduce_block(values, word, count, reduce_op);
+                result = result ? reduce_op(*result, block_result) : block_result;
+            });
+
+            return result;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,194 @@
+#ifndef RCU_HPP
+#define RCU_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// RCU (read-copy-update) with epoch based reclamation
+// - readers never block: entering a read section is one store of the current epoch to a thread local record
+// - writers copy the current value, modify the copy and publish it with an atomic exchange
+// - an old value is retired with the epoch of its replacement - it is deleted when every thread
+//   is quiescent or has entered its read section after that epoch (readers are never waited for)
+// - read sections may be nested
+// - synchronize() waits for a grace period - read sections that could still see a replaced value have ended
+
+namespace Rcu
+{
+    namespace Details
+    {
+        struct ThreadRecord
+        {
+            std::atomic<uint64_t> epoch{0}; // 0 - quiescent
+            std::atomic<bool> is_used{true};
+            ThreadRecord* next{};
+            unsigned nesting{}; // accessed only by the owner
+        };
+
+        inline std::atomic<uint64_t> global_epoch{1};
+        inline std::atomic<ThreadRecord*> thread_records{nullptr};
+
+        // records are never deleted - a record of a finished thread is reused
+        inline ThreadRecord* acquire_thread_record()
+        {
+            for (ThreadRecord* record = thread_records.load(std::memory_order_acquire); record; record = record->next)
+            {
+                bool expected = false;
+                if (!record->is_used.load(std::memory_order_relaxed)
+                    && record->is_used.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    return record;
+            }
+
+            auto* record = new ThreadRecord{};
+            record->next = thread_records.load(std::memory_order_relaxed);
+            while (!thread_records.compare_exchange_weak(record->next, record, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+            }
+            return record;
+        }
+
+        struct ThreadRecordOwner
+        {
+            ThreadRecord* record = acquire_thread_record();
+
+            ~ThreadRecordOwner()
+            {
+                record->is_used.store(false, std::memory_order_release);
+            }
+        };
+
+        inline ThreadRecord& this_thread_record()
+        {
+            thread_local ThreadRecordOwner owner;
+            return *owner.record;
+        }
+
+        // true if no thread can still read a value retired with epoch
+        inline bool is_reclaimable(uint64_t epoch)
+        {
+            for (ThreadRecord* record = thread_records.load(std::memory_order_seq_cst); record; record = record->next)
+            {
+                const uint64_t thread_epoch = record->epoch.load(std::memory_order_seq_cst);
+                if (thread_epoch != 0 && thread_epoch < epoch)
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    class ReadGuard
+    {
+        Details::ThreadRecord& record_;
+
+    public:
+        ReadGuard()
+            : record_{Details::this_thread_record()}
+        {
+            if (record_.nesting++ == 0)
+                record_.epoch.store(Details::global_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        ~ReadGuard()
+        {
+            if (--record_.nesting == 0)
+                record_.epoch.store(0, std::memory_order_release);
+        }
+    };
+
+    inline bool is_in_read_section()
+    {
+        return Details::this_thread_record().nesting > 0;
+    }
+
+    // waits until every read section entered before the call has ended - values replaced before the call
+    // are no longer read by any thread; must not be called inside a read section (it would wait for itself)
+    inline void synchronize()
+    {
+        const uint64_t epoch = Details::global_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+
+        while (!Details::is_reclaimable(epoch))
+            std::this_thread::yield();
+    }
+
+    template <typename T>
+    class rcu_ptr
+    {
+        std::atomic<const T*> current_;
+        std::mutex mtx_writers_;
+        std::vector<std::pair<const T*, uint64_t>> retired_;
+
+        void reclaim()
+        {
+            std::erase_if(retired_, [](const auto& retired) {
+                if (!Details::is_reclaimable(retired.second))
+                    return false;
+
+                delete retired.first;
+                return true;
+            });
+        }
+
+    public:
+        explicit rcu_ptr(T value = T{})
+            : current_{new T(std::move(value))}
+        {
+        }
+
+        rcu_ptr(const rcu_ptr&) = delete;
+        rcu_ptr& operator=(const rcu_ptr&) = delete;
+
+        // no readers may be active
+        ~rcu_ptr()
+        {
+            for (const auto& [value, epoch] : retired_)
+                delete value;
+            delete current_.load();
+        }
+
+        // the value is valid until the end of the read section of the calling thread
+        const T& get(const ReadGuard&) const
+        {
+            return *current_.load(std::memory_order_seq_cst);
+        }
+
+        template <typename TFunction>
+        decltype(auto) read(TFunction&& f) const
+        {
+            ReadGuard read_guard;
+            return std::forward<TFunction>(f)(get(read_guard));
+        }
+
+        // modify is called for a copy of the current value - writers are serialized, readers are not blocked
+        template <typename TFunction>
+        void update(TFunction&& modify)
+        {
+            std::lock_guard lk{mtx_writers_};
+
+            auto copy = std::make_unique<T>(*current_.load(std::memory_order_relaxed));
+            std::forward<TFunction>(modify)(*copy);
+
+            const T* old_value = current_.exchange(copy.release(), std::memory_order_seq_cst);
+            const uint64_t epoch = Details::global_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+            retired_.emplace_back(old_value, epoch);
+
+            reclaim();
+        }
+
+        size_t retired_count()
+        {
+            std::lock_guard lk{mtx_writers_};
+            reclaim();
+            return retired_.size();
+        }
+    };
+}
+
+#endif
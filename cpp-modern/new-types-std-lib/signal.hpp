@@ -0,0 +1,155 @@
+#ifndef SIGNAL_HPP
+#define SIGNAL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "rcu.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// signal<T> - strongly typed event bus
+//   signal<double> temp_changed;
+//   temp_changed.connect<&Logger::on_temp_changed>(logger);
+//   temp_changed.emit(23.88);
+// - subscribers are stored contiguously: a delivery function and a callable stored inline in a slot
+// - callables must be small & trivially copyable (lambdas capturing pointers or references, function pointers)
+// - a subscriber takes a single value (const T&) or a batch (std::span<const T>)
+// - queue() coalesces readings - they are delivered as one batch per subscriber by flush() or when the batch is full
+// - the list of subscribers is an RCU snapshot: connect() & disconnect() may be called from any thread (also from
+//   a subscriber) and never block emit()
+// - disconnect() waits until emits in progress on other threads are finished - after it returns the subscriber
+//   is not called anymore and may be destroyed; called from a subscriber (inside emit) it doesn't wait,
+//   so the emit in progress on the calling thread may still call the disconnected subscriber
+// - emit() only reads the snapshot - it may be called from many threads at once (subscribers are then called concurrently);
+//   queue() & flush() share a pending batch - they are called by one producer thread at a time
+
+namespace Signals
+{
+    using connection_id = uint64_t;
+
+    template <typename T>
+    class signal
+    {
+    public:
+        static constexpr size_t max_callable_size = 3 * sizeof(void*);
+
+    private:
+        struct Slot
+        {
+            connection_id id;
+            void (*deliver)(const void* callable, std::span<const T> values);
+            alignas(void*) std::byte callable[max_callable_size];
+        };
+
+        template <typename F>
+        static void deliver(const void* callable, std::span<const T> values)
+        {
+            const F& f = *std::launder(static_cast<const F*>(callable));
+
+            if constexpr (std::is_invocable_v<const F&, std::span<const T>>)
+                f(values);
+            else
+                for (const auto& value : values)
+                    f(value);
+        }
+
+        Rcu::rcu_ptr<std::vector<Slot>> slots_;
+        connection_id next_id_ = 1; // guarded by the writers lock of slots_
+        std::vector<T> pending_;
+        size_t batch_capacity_;
+
+    public:
+        explicit signal(size_t batch_capacity = 64)
+            : batch_capacity_{batch_capacity}
+        {
+            pending_.reserve(batch_capacity_);
+        }
+
+        template <typename F>
+            requires std::is_invocable_v<const F&, const T&> || std::is_invocable_v<const F&, std::span<const T>>
+        connection_id connect(F f)
+        {
+            static_assert(sizeof(F) <= max_callable_size && alignof(F) <= alignof(void*), "callable is too large");
+            static_assert(std::is_trivially_copyable_v<F>, "callable must be trivially copyable");
+
+            connection_id id{};
+
+            slots_.update([&](std::vector<Slot>& slots) {
+                Slot& slot = slots.emplace_back();
+                slot.id = id = next_id_++;
+                slot.deliver = &deliver<F>;
+                ::new (slot.callable) F(f);
+            });
+
+            return id;
+        }
+
+        template <auto Method, typename TSubscriber>
+        connection_id connect(TSubscriber& subscriber)
+        {
+            if constexpr (std::is_invocable_v<decltype(Method), TSubscriber*, std::span<const T>>)
+                return connect([subscriber = &subscriber](std::span<const T> values) { std::invoke(Method, subscriber, values); });
+            else
+                return connect([subscriber = &subscriber](const T& value) { std::invoke(Method, subscriber, value); });
+        }
+
+        bool disconnect(connection_id id)
+        {
+            bool is_removed = false;
+
+            slots_.update([&](std::vector<Slot>& slots) {
+                is_removed = std::erase_if(slots, [id](const Slot& slot) { return slot.id == id; }) > 0;
+            });
+
+            // emits on other threads may still use the old snapshot - waiting inside emit would deadlock
+            if (is_removed && !Rcu::is_in_read_section())
+                Rcu::synchronize();
+
+            return is_removed;
+        }
+
+        size_t size() const
+        {
+            return slots_.read([](const std::vector<Slot>& slots) { return slots.size(); });
+        }
+
+        void emit(const T& value)
+        {
+            emit(std::span<const T>{&value, 1});
+        }
+
+        void emit(std::span<const T> values)
+        {
+            slots_.read([values](const std::vector<Slot>& slots) {
+                for (const auto& slot : slots)
+                    slot.deliver(slot.callable, values);
+            });
+        }
+
+        void queue(const T& value)
+        {
+            pending_.push_back(value);
+
+            if (pending_.size() >= batch_capacity_)
+                flush();
+        }
+
+        void flush()
+        {
+            if (pending_.empty())
+                return;
+
+            emit(std::span<const T>{pending_});
+            pending_.clear();
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef TOKENIZER_HPP
+#define TOKENIZER_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TOKENIZER_SSE2
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// zero-allocation tokenizer yielding std::string_view tokens
+// - delimiters are located 64 bytes at a time: SIMD compares give a 64-bit mask of delimiter positions
+// - token boundaries are found with std::countr_zero on the mask (bitmask iteration)
+// - consecutive delimiters are collapsed - empty tokens are never yielded (unlike std::views::split)
+// - delimiters are copied into the view (it may be built from a temporary string) - tokens refer to the text
+
+namespace Tokenizer
+{
+    class DelimiterSet
+    {
+    public:
+        static constexpr size_t max_simd_delimiters = 8;
+
+    private:
+        std::array<bool, 256> is_delimiter_{};
+        std::array<char, max_simd_delimiters> simd_delimiters_{}; // the first distinct delimiters
+        size_t distinct_count_{};
+
+    public:
+        explicit DelimiterSet(std::string_view delimiters)
+        {
+            for (unsigned char c : delimiters)
+            {
+                if (is_delimiter_[c])
+                    continue;
+
+                is_delimiter_[c] = true;
+                if (distinct_count_ < max_simd_delimiters)
+                    simd_delimiters_[distinct_count_] = static_cast<char>(c);
+                ++distinct_count_;
+            }
+        }
+
+        bool contains(char c) const
+        {
+            return is_delimiter_[static_cast<unsigned char>(c)];
+        }
+
+        // bit i is set if data[i] is a delimiter, for i < count (count <= 64)
+        uint64_t scalar_mask(const char* data, size_t count) const
+        {
+            uint64_t mask = 0;
+            for (size_t i = 0; i < count; ++i)
+                mask |= uint64_t{contains(data[i])} << i;
+            return mask;
+        }
+
+        // bit i is set if data[i] is a delimiter, for i < 64
+        uint64_t block_mask(const char* data) const
+        {
+#ifdef TOKENIZER_SSE2
+            if (distinct_count_ <= max_simd_delimiters)
+            {
+                uint64_t mask = 0;
+
+                for (size_t chunk = 0; chunk < 4; ++chunk)
+                {
+                    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * chunk));
+                    __m128i matches = _mm_setzero_si128();
+
+                    for (size_t i = 0; i < distinct_count_; ++i)
+                        matches = _mm_or_si128(matches, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(simd_delimiters_[i])));
+
+                    mask |= uint64_t{static_cast<uint16_t>(_mm_movemask_epi8(matches))} << (16 * chunk);
+                }
+
+                return mask;
+            }
+#endif
+            return scalar_mask(data, 64);
+        }
+    };
+
+    class token_view : public std::ranges::view_interface<token_view>
+    {
+        std::string_view text_;
+        DelimiterSet delimiters_;
+
+    public:
+        class iterator
+        {
+            const token_view* view_{};
+            size_t token_begin_{};
+            size_t token_end_{};
+            size_t block_begin_ = SIZE_MAX; // cached mask of delimiters
+            uint64_t block_mask_{};
+
+            uint64_t mask_for(size_t block_begin)
+            {
+                if (block_begin != block_begin_)
+                {
+                    const auto& text = view_->text_;
+                    const size_t count = std::min<size_t>(64, text.size() - block_begin);
+
+                    block_mask_ = count == 64 ? view_->delimiters_.block_mask(text.data() + block_begin)
+                                              : view_->delimiters_.scalar_mask(text.data() + block_begin, count);
+                    block_begin_ = block_begin;
+                }
+
+                return block_mask_;
+            }
+
+            // index of the first byte at or after pos which is (or is not) a delimiter
+            size_t find(size_t pos, bool find_delimiter)
+            {
+                const size_t size = view_->text_.size();
+
+                while (pos < size)
+                {
+                    const size_t block_begin = pos & ~size_t{63};
+                    const size_t valid_count = std::min<size_t>(64, size - block_begin);
+
+                    uint64_t mask = mask_for(block_begin);
+                    if (!find_delimiter)
+                        mask = ~mask;
+                    if (valid_count < 64)
+                        mask &= (uint64_t{1} << valid_count) - 1;
+                    mask &= ~uint64_t{0} << (pos & 63);
+
+                    if (mask != 0)
+                        return block_begin + std::countr_zero(mask);
+
+                    pos = block_begin + 64;
+                }
+
+                return size;
+            }
+
+            void next_token(size_t pos)
+            {
+                token_begin_ = find(pos, false);
+                token_end_ = find(token_begin_, true);
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::string_view;
+
+            iterator() = default;
+
+            iterator(const token_view& view)
+                : view_{&view}
+            {
+                next_token(0);
+            }
+
+            std::string_view operator*() const
+            {
+                return view_->text_.substr(token_begin_, token_end_ - token_begin_);
+            }
+
+            iterator& operator++()
+            {
+                next_token(token_end_);
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                auto temp = *this;
+                ++*this;
+                return temp;
+            }
+
+            bool operator==(const iterator& other) const
+            {
+                return token_begin_ == other.token_begin_;
+            }
+
+            bool operator==(std::default_sentinel_t) const
+            {
+                return token_begin_ == view_->text_.size();
+            }
+        };
+
+        token_view(std::string_view text, std::string_view delimiters)
+            : text_{text}
+            , delimiters_{delimiters}
+        {
+        }
+
+        iterator begin() const
+        {
+            return iterator{*this};
+        }
+
+        std::default_sentinel_t end() const
+        {
+            return std::default_sentinel;
+        }
+    };
+
+    inline token_view tokenize(std::string_view text, std::string_view delimiters = " \t\r\n")
+    {
+        return token_view{text, delimiters};
+    }
+}
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef VARIANT_VECTOR_HPP
+#define VARIANT_VECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// variant_vector<Ts...> - structure of arrays replacement of std::vector<std::variant<Ts...>>
+// - each alternative is stored in its own contiguous std::vector<T> - no padding to the size of the largest alternative
+// - for_each_alternative(f) calls f(std::span<const T>) for each alternative - tight loops without a dispatch per element
+// - Ordering::preserved keeps an order index (alternative, position) packed in 8 bytes per item
+//   - for_each(f) & at(i) in the insertion order
+
+namespace VariantVector
+{
+    enum class Ordering
+    {
+        by_alternative,
+        preserved
+    };
+
+    template <typename... Ts>
+    class variant_vector
+    {
+        static_assert(sizeof...(Ts) > 0 && sizeof...(Ts) <= 255, "alternative index is stored in one byte");
+
+        // alternative in the high byte, position in the low 56 bits
+        using Location = uint64_t;
+        static constexpr unsigned position_bits = 56;
+        static constexpr Location position_mask = (Location{1} << position_bits) - 1;
+
+        std::tuple<std::vector<Ts>...> alternatives_;
+        Ordering ordering_;
+        std::vector<Location> order_;
+
+        template <typename T>
+        static constexpr size_t index_of()
+        {
+            constexpr bool matches[] = {std::is_same_v<T, Ts>...};
+            for (size_t i = 0; i < sizeof...(Ts); ++i)
+                if (matches[i])
+                    return i;
+            return sizeof...(Ts);
+        }
+
+        template <typename T>
+        static constexpr bool is_alternative = ((std::is_same_v<T, Ts> ? 1 : 0) + ...) == 1;
+
+        template <typename T>
+        void record(const std::vector<T>& items)
+        {
+            if (ordering_ == Ordering::preserved)
+                order_.push_back(Location{index_of<T>()} << position_bits | (items.size() - 1));
+        }
+
+        template <typename F, size_t... Is>
+        void visit_location(Location location, F&& f, std::index_sequence<Is...>) const
+        {
+            const size_t alternative = location >> position_bits;
+            const size_t position = location & position_mask;
+            ((alternative == Is ? (f(std::get<Is>(alternatives_)[position]), true) : false) || ...);
+        }
+
+    public:
+        using value_type = std::variant<Ts...>;
+
+        explicit variant_vector(Ordering ordering = Ordering::by_alternative)
+            : ordering_{ordering}
+        {
+        }
+
+        Ordering ordering() const
+        {
+            return ordering_;
+        }
+
+        size_t size() const
+        {
+            return (std::get<std::vector<Ts>>(alternatives_).size() + ...);
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        template <typename T>
+            requires is_alternative<T>
+        size_t count() const
+        {
+            return std::get<std::vector<T>>(alternatives_).size();
+        }
+
+        template <typename T>
+            requires is_alternative<T>
+        void reserve(size_t capacity)
+        {
+            std::get<std::vector<T>>(alternatives_).reserve(capacity);
+        }
+
+        void clear()
+        {
+            (std::get<std::vector<Ts>>(alternatives_).clear(), ...);
+            order_.clear();
+        }
+
+        template <typename T, typename... TArgs>
+            requires is_alternative<T>
+        T& emplace_back(TArgs&&... args)
+        {
+            auto& items = std::get<std::vector<T>>(alternatives_);
+            T& item = items.emplace_back(std::forward<TArgs>(args)...);
+            record(items);
+            return item;
+        }
+
+        template <typename T>
+            requires is_alternative<std::remove_cvref_t<T>>
+        void push_back(T&& item)
+        {
+            emplace_back<std::remove_cvref_t<T>>(std::forward<T>(item));
+        }
+
+        void push_back(const value_type& item)
+        {
+            std::visit([this](const auto& alternative) { push_back(alternative); }, item);
+        }
+
+        template <typename T>
+            requires is_alternative<T>
+        std::span<const T> get() const
+        {
+            return std::get<std::vector<T>>(alternatives_);
+        }
+
+        template <typename T>
+            requires is_alternative<T>
+        std::span<T> get()
+        {
+            return std::get<std::vector<T>>(alternatives_);
+        }
+
+        // f(std::span<const T>) is called for each alternative T
+        template <typename F>
+        void for_each_alternative(F f) const
+        {
+            (f(get<Ts>()), ...);
+        }
+
+        // f(const T&) is called for each item - in the insertion order if the order is preserved
+        template <typename F>
+        void for_each(F f) const
+        {
+            if (ordering_ == Ordering::preserved)
+            {
+                for (Location location : order_)
+                    visit_location(location, f, std::index_sequence_for<Ts...>{});
+            }
+            else
+            {
+                for_each_alternative([&f](auto items) {
+                    for (const auto& item : items)
+                        f(item);
+                });
+            }
+        }
+
+        // requires Ordering::preserved
+        value_type at(size_t index) const
+        {
+            if (ordering_ != Ordering::preserved)
+                throw std::logic_error("variant_vector: order of items is not preserved");
+
+            std::optional<value_type> result;
+            visit_location(order_.at(index), [&result](const auto& item) { result.emplace(item); }, std::index_sequence_for<Ts...>{});
+            return *result;
+        }
+    };
+}
+
+#endif
@@ -1,9 +1,22 @@
 #include "catch.hpp"
+#include "async_dispatcher.hpp"
+#include "benchmark_utils.hpp"
+#include "compact_optional.hpp"
+#include "env_snapshot.hpp"
+#include "fast_visit.hpp"
+#include "float_parser.hpp"
+#include "inline_any.hpp"
+#include "int_parser.hpp"
+#include "nullable_column.hpp"
+#include "rcu.hpp"
+#include "signal.hpp"
+#include "tokenizer.hpp"
 
 #include <algorithm>
 #include <any>
 #include <array>
 #include <iostream>
+#include <limits>
 #include <list>
 #include <map>
 #include <numeric>
@@ -15,7 +28,16 @@
 #include <variant>
 #include <vector>
 #include <atomic>
+#include <bit>
+#include <cmath>
+#include <charconv>
+#include <chrono>
 #include <ranges>
+#include <random>
+#include <thread>
+#include <span>
+#include <typeinfo>
+#include <memory>
 
 using namespace std::literals;
 
@@ -78,6 +100,102 @@ TEST_CASE("string_view")
     }
 }
 
+TEST_CASE("tokenizer - string_view tokens without allocations")
+{
+    using Tokenizer::tokenize;
+
+    SECTION("whitespace")
+    {
+        std::string text = "abc def  ghi\tjkl\n";
+
+        std::vector<std::string_view> tokens_from_loop;
+        for (std::string_view token : tokenize(text))
+            tokens_from_loop.push_back(token);
+
+        REQUIRE(tokens_from_loop == std::vector{"abc"sv, "def"sv, "ghi"sv, "jkl"sv});
+        REQUIRE(tokens_from_loop.front().data() == text.data()); // tokens point into the text
+    }
+
+    SECTION("custom delimiters")
+    {
+        std::vector<std::string_view> tokens;
+        for (auto token : tokenize(";;a;bb,ccc;", ";,"))
+            tokens.push_back(token);
+
+        REQUIRE(tokens == std::vector{"a"sv, "bb"sv, "ccc"sv});
+    }
+
+    SECTION("empty text & only delimiters")
+    {
+        REQUIRE(std::ranges::distance(tokenize("")) == 0);
+        REQUIRE(std::ranges::distance(tokenize("   \t\n  ")) == 0);
+    }
+
+    SECTION("tokens crossing 64-byte blocks - the same as std::views::split")
+    {
+        std::string text;
+        for (int i = 0; i < 1000; ++i)
+            text += std::string(i % 13 + 1, 'a' + i % 26) + std::string(i % 3 + 1, ' ');
+
+        std::vector<std::string_view> expected;
+        for (auto token : text | std::views::split(' '))
+            if (!token.empty())
+                expected.emplace_back(token.begin(), token.end());
+
+        std::vector<std::string_view> tokens;
+        for (auto token : tokenize(text, " "))
+            tokens.push_back(token);
+
+        REQUIRE(tokens == expected);
+    }
+
+    SECTION("more delimiters than SIMD compares")
+    {
+        std::string text(200, 'x');
+        text[70] = '7';
+        text[140] = '!';
+
+        std::vector<std::string_view> tokens;
+        for (auto token : tokenize(text, "0123456789!"))
+            tokens.push_back(token);
+
+        REQUIRE(tokens.size() == 3);
+        REQUIRE(tokens[1].size() == 69);
+    }
+
+    SECTION("delimiters are copied - a temporary string may be passed")
+    {
+        std::string text(200, 'x');
+        text[70] = ';';
+
+        auto tokens = tokenize(text, std::string{";,"});
+
+        REQUIRE(std::ranges::distance(tokens) == 2);
+        REQUIRE(*tokens.begin() == std::string(70, 'x'));
+    }
+}
+
+TEST_CASE("tokenizer vs. std::views::split", "[.][benchmark]")
+{
+    std::string text;
+    while (text.size() < 64 * 1024 * 1024)
+        text += "lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor ";
+
+    Benchmark::measure("Tokenizer::tokenize", [&] {
+        size_t count = 0;
+        for (auto token : Tokenizer::tokenize(text, " "))
+            count += !token.empty();
+        return count;
+    }, " tokens");
+
+    Benchmark::measure("std::views::split  ", [&] {
+        size_t count = 0;
+        for (auto token : text | std::views::split(' '))
+            count += !token.empty();
+        return count;
+    }, " tokens");
+}
+
 std::string_view get_prefix(std::string_view text, size_t length)
 {
     return {text.data(), length};
@@ -175,6 +293,140 @@ TEST_CASE("std::any")
     }
 }
 
+TEST_CASE("inline_any")
+{
+    using InlineAny::inline_any;
+    using InlineAny::any_cast;
+
+    inline_any<> anything;
+
+    REQUIRE(anything.has_value() == false);
+
+    anything = 42;
+    anything = 3.14;
+    anything = "text"s;
+    anything = std::vector {1, 2, 3};
+
+    static_assert(inline_any<>::is_stored_inline<std::vector<int>>());
+    static_assert(!inline_any<>::is_stored_inline<std::array<int, 16>>());
+
+    SECTION("any_cast returning copy")
+    {
+        auto vec = any_cast<std::vector<int>>(anything);
+        REQUIRE(vec == std::vector {1, 2, 3});
+
+        REQUIRE_THROWS_AS(any_cast<std::string>(anything), std::bad_any_cast);
+    }
+
+    SECTION("any_cast returning pointer")
+    {
+        anything = 3.14;
+
+        double* ptr_pi = any_cast<double>(&anything);
+        REQUIRE(ptr_pi != nullptr);
+        *ptr_pi = 3.1415;
+        REQUIRE(any_cast<double>(anything) == 3.1415);
+
+        REQUIRE(any_cast<float>(&anything) == nullptr);
+        REQUIRE(any_cast<const double>(&anything) == ptr_pi); // cv-qualifiers are ignored - like std::any
+
+        std::any std_anything = 3.14;
+        REQUIRE(std::any_cast<const double>(&std_anything) != nullptr);
+    }
+
+    SECTION("copy & move - inline and on the heap")
+    {
+        inline_any<> large = std::array<int, 16>{1, 2, 3};
+        inline_any<> copy_of_large = large;
+        inline_any<> copy_of_vector = anything;
+
+        REQUIRE(any_cast<std::array<int, 16>&>(copy_of_large)[2] == 3);
+        REQUIRE(any_cast<std::vector<int>&>(copy_of_vector) == std::vector{1, 2, 3});
+
+        inline_any<> target = std::move(large);
+        REQUIRE(large.has_value() == false);
+        REQUIRE(target.is<std::array<int, 16>>());
+
+        target.swap(copy_of_vector);
+        REQUIRE(target.is<std::vector<int>>());
+        REQUIRE(copy_of_vector.is<std::array<int, 16>>());
+
+        target.reset();
+        REQUIRE(target.has_value() == false);
+    }
+
+    SECTION("emplace")
+    {
+        auto& text = anything.emplace<std::string>(3, 'a');
+        REQUIRE(text == "aaa");
+        REQUIRE(any_cast<std::string>(anything) == "aaa");
+
+        anything.emplace<const int>(42); // decayed - like std::any::emplace
+        REQUIRE(anything.is<int>());
+        REQUIRE(any_cast<int>(anything) == 42);
+    }
+
+    SECTION("in_place_type")
+    {
+        inline_any<> zero{std::in_place_type<int>};
+        REQUIRE(zero.is<int>());
+        REQUIRE(any_cast<int>(zero) == 0);
+
+        inline_any<> text{std::in_place_type<std::string>, 3, 'a'};
+        REQUIRE(any_cast<std::string&>(text) == "aaa");
+    }
+
+    SECTION("buffer with a small alignment stores a heap pointer aligned")
+    {
+        static_assert(alignof(inline_any<16, 1>) >= alignof(void*));
+
+        inline_any<16, 1> large = std::array<int, 16>{1, 2, 3};
+        REQUIRE(any_cast<std::array<int, 16>&>(large)[2] == 3);
+    }
+}
+
+TEST_CASE("inline_any vs. std::any", "[.][benchmark]")
+{
+    constexpr int count = 10'000'000;
+
+    auto benchmark = [&]<typename TAny>(std::string_view desc, auto cast, auto value) {
+        std::cout << "\n" << desc << ":\n";
+
+        Benchmark::measure("  construct + cast", [&] {
+            size_t result = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                TAny anything = value;
+                result += cast(&anything) != nullptr;
+            }
+            return result;
+        });
+
+        TAny source = value;
+        Benchmark::measure("  copy + cast     ", [&] {
+            size_t result = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                TAny anything = source;
+                result += cast(&anything) != nullptr;
+            }
+            return result;
+        });
+    };
+
+    auto run = [&](std::string_view type_name, auto value) {
+        using T = decltype(value);
+        benchmark.template operator()<std::any>(
+            "std::any<"s + std::string(type_name) + ">", [](auto* a) { return std::any_cast<T>(a); }, value);
+        benchmark.template operator()<InlineAny::inline_any<>>(
+            "InlineAny::inline_any<"s + std::string(type_name) + ">", [](auto* a) { return InlineAny::any_cast<T>(a); }, value);
+    };
+
+    run("int", 42);
+    run("std::string", "text longer than SSO of std::string"s);
+    run("std::array<int, 6>", std::array<int, 6>{1, 2, 3, 4, 5, 6});
+}
+
 ////////////////////////////////////
 // wide interfaces
 
@@ -212,6 +464,463 @@ public:
     }
 };
 
+////////////////////////////////////
+// strongly typed event bus - no std::any, no strings & no virtual calls in the hot path
+
+namespace TypedEvents
+{
+    class TempMonitor
+    {
+    public:
+        Signals::signal<double> temp_changed;
+
+        void notify()
+        {
+            temp_changed.emit(get_temp());
+        }
+
+        void read_sensor(double temp)
+        {
+            temp_changed.queue(temp); // coalesced into batches
+        }
+
+        double get_temp() const
+        {
+            return 23.88;
+        }
+    };
+
+    class Logger
+    {
+    public:
+        double last_temp{};
+        size_t count{};
+
+        void on_temp_changed(double temp)
+        {
+            last_temp = temp;
+            ++count;
+        }
+    };
+
+    class Statistics
+    {
+    public:
+        double sum{};
+        size_t batches{};
+
+        void on_temp_batch(std::span<const double> temps)
+        {
+            sum = std::accumulate(temps.begin(), temps.end(), sum);
+            ++batches;
+        }
+    };
+}
+
+TEST_CASE("signal - typed observers")
+{
+    TypedEvents::TempMonitor monitor;
+    TypedEvents::Logger logger;
+    TypedEvents::Statistics stats;
+    double max_temp = 0.0;
+
+    monitor.temp_changed.connect<&TypedEvents::Logger::on_temp_changed>(logger);
+    monitor.temp_changed.connect<&TypedEvents::Statistics::on_temp_batch>(stats);
+    const auto max_id = monitor.temp_changed.connect([&max_temp](double temp) { max_temp = std::max(max_temp, temp); });
+
+    SECTION("emit - single value")
+    {
+        monitor.notify();
+
+        REQUIRE(logger.last_temp == 23.88);
+        REQUIRE(stats.sum == 23.88);
+        REQUIRE(max_temp == 23.88);
+    }
+
+    SECTION("queue - batch delivery of coalesced readings")
+    {
+        Signals::signal<double> temp_changed{4};
+        temp_changed.connect<&TypedEvents::Logger::on_temp_changed>(logger);
+        temp_changed.connect<&TypedEvents::Statistics::on_temp_batch>(stats);
+
+        for (double temp : {1.0, 2.0, 3.0, 4.0, 5.0})
+            temp_changed.queue(temp);
+
+        REQUIRE(stats.batches == 1); // batch full after 4 readings
+        REQUIRE(logger.count == 4);
+
+        temp_changed.flush();
+
+        REQUIRE(stats.batches == 2);
+        REQUIRE(stats.sum == 15.0);
+        REQUIRE(logger.count == 5);
+        REQUIRE(logger.last_temp == 5.0);
+    }
+
+    SECTION("disconnect")
+    {
+        REQUIRE(monitor.temp_changed.disconnect(max_id));
+        REQUIRE_FALSE(monitor.temp_changed.disconnect(max_id));
+        REQUIRE(monitor.temp_changed.size() == 2);
+
+        monitor.notify();
+        REQUIRE(max_temp == 0.0);
+    }
+}
+
+TEST_CASE("rcu_ptr - copy on write updates")
+{
+    Rcu::rcu_ptr<std::vector<int>> numbers{{1, 2, 3}};
+
+    SECTION("readers see a snapshot - it is reclaimed after the read section")
+    {
+        {
+            Rcu::ReadGuard read_guard;
+            const auto& snapshot = numbers.get(read_guard);
+
+            numbers.update([](std::vector<int>& copy) { copy.push_back(4); });
+
+            REQUIRE(snapshot == std::vector{1, 2, 3});
+            REQUIRE(numbers.get(read_guard) == std::vector{1, 2, 3, 4});
+            REQUIRE(numbers.retired_count() == 1);
+        }
+
+        REQUIRE(numbers.retired_count() == 0);
+    }
+
+    SECTION("nested read sections")
+    {
+        Rcu::ReadGuard outer;
+        const auto& snapshot = numbers.get(outer);
+
+        {
+            Rcu::ReadGuard inner;
+        }
+
+        numbers.update([](std::vector<int>& copy) { copy.clear(); });
+        REQUIRE(numbers.retired_count() == 1);
+        REQUIRE(snapshot.size() == 3);
+    }
+}
+
+TEST_CASE("signal - connect & disconnect while emitting on other threads")
+{
+    Signals::signal<double> temp_changed;
+    std::atomic<size_t> deliveries{};
+
+    {
+        // concurrent emit() is safe - stop is requested by ~jthread also when a REQUIRE throws
+        std::vector<std::jthread> sensors;
+        for (int i = 0; i < 2; ++i)
+            sensors.emplace_back([&](std::stop_token stop) {
+                while (!stop.stop_requested())
+                    temp_changed.emit(23.88);
+            });
+
+        for (int i = 0; i < 1'000; ++i)
+        {
+            const auto id = temp_changed.connect([&deliveries](double) { deliveries.fetch_add(1, std::memory_order_relaxed); });
+            REQUIRE(temp_changed.disconnect(id));
+        }
+
+        temp_changed.connect([&deliveries](double) { deliveries.fetch_add(1, std::memory_order_relaxed); });
+        const size_t deliveries_before = deliveries;
+        while (deliveries == deliveries_before)
+            std::this_thread::yield();
+    }
+
+    REQUIRE(temp_changed.size() == 1);
+}
+
+TEST_CASE("signal - subscriber destroyed right after disconnect")
+{
+    struct Counter
+    {
+        std::atomic<size_t> count{};
+
+        void on_temp_changed(double)
+        {
+            count.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    Signals::signal<double> temp_changed;
+    std::atomic<size_t> late_calls{};
+
+    std::vector<std::jthread> sensors;
+    for (int i = 0; i < 2; ++i)
+        sensors.emplace_back([&](std::stop_token stop) {
+            while (!stop.stop_requested())
+                temp_changed.emit(23.88);
+        });
+
+    for (int i = 0; i < 200; ++i)
+    {
+        auto counter = std::make_unique<Counter>();
+        std::atomic<bool> is_destroyed{false};
+
+        // the flag outlives the counter - a call still running when disconnect returned is counted as late
+        const auto id = temp_changed.connect([counter = counter.get(), &is_destroyed, &late_calls](double temp) {
+            counter->on_temp_changed(temp);
+            if (is_destroyed)
+                late_calls.fetch_add(1);
+        });
+
+        while (counter->count == 0)
+            std::this_thread::yield();
+
+        REQUIRE(temp_changed.disconnect(id));
+        is_destroyed = true;
+        counter.reset();
+    }
+
+    sensors.clear();
+    REQUIRE(late_calls == 0);
+}
+
+TEST_CASE("async_dispatcher - asynchronous notifications")
+{
+    using Signals::BackPressure;
+
+    TypedEvents::TempMonitor monitor;
+    Signals::async_dispatcher<double> dispatcher{2};
+    monitor.temp_changed.connect([&dispatcher](std::span<const double> temps) { dispatcher.post(temps); });
+
+    SECTION("block - every notification is delivered in order")
+    {
+        std::vector<double> temps;
+        const auto id = dispatcher.connect([&temps](double temp) { temps.push_back(temp); }, BackPressure::block, 4);
+
+        for (int i = 0; i < 100; ++i)
+            monitor.temp_changed.emit(i);
+        dispatcher.wait_idle();
+
+        REQUIRE(temps.size() == 100);
+        REQUIRE(std::ranges::is_sorted(temps));
+
+        const auto stats = dispatcher.stats(id).value();
+        REQUIRE(stats.delivered == 100);
+        REQUIRE(stats.dropped == 0);
+        REQUIRE(stats.max_latency >= stats.mean_latency);
+    }
+
+    SECTION("slow subscriber doesn't stall the producer")
+    {
+        std::atomic<bool> is_released{false};
+        std::atomic<double> last_oldest{}, last_latest{};
+
+        auto slow_handler = [&is_released](std::atomic<double>& last) {
+            return [&](double temp) {
+                is_released.wait(false);
+                last = temp;
+            };
+        };
+
+        const auto oldest_id = dispatcher.connect(slow_handler(last_oldest), BackPressure::drop_oldest, 4);
+        const auto latest_id = dispatcher.connect(slow_handler(last_latest), BackPressure::coalesce_latest, 4);
+
+        for (int i = 1; i <= 100; ++i)
+            monitor.temp_changed.emit(i);
+
+        is_released = true;
+        is_released.notify_all();
+        dispatcher.wait_idle();
+
+        const auto oldest_stats = dispatcher.stats(oldest_id).value();
+        REQUIRE(oldest_stats.posted == 100);
+        REQUIRE(oldest_stats.dropped >= 95);
+        REQUIRE(oldest_stats.delivered + oldest_stats.dropped == 100);
+        REQUIRE(last_oldest == 100.0);
+
+        const auto latest_stats = dispatcher.stats(latest_id).value();
+        REQUIRE(latest_stats.coalesced >= 95);
+        REQUIRE(latest_stats.delivered + latest_stats.coalesced == 100);
+        REQUIRE(last_latest == 100.0);
+    }
+
+    SECTION("disconnect")
+    {
+        const auto id = dispatcher.connect([](double) {});
+        REQUIRE(dispatcher.disconnect(id));
+        REQUIRE(dispatcher.stats(id) == std::nullopt);
+        REQUIRE_FALSE(dispatcher.disconnect(id));
+    }
+
+    SECTION("disconnect waits for a running handler")
+    {
+        std::atomic<bool> is_running{false}, is_finished{false};
+
+        const auto id = dispatcher.connect([&](double) {
+            is_running = true;
+            is_running.notify_all();
+            std::this_thread::sleep_for(20ms);
+            is_finished = true;
+        });
+
+        monitor.temp_changed.emit(1.0);
+        is_running.wait(false);
+
+        REQUIRE(dispatcher.disconnect(id));
+        REQUIRE(is_finished);
+    }
+
+    SECTION("disconnect a subscriber while the producer waits for its full ring buffer")
+    {
+        std::atomic<bool> is_running{false}, is_released{false}, is_posted{false};
+
+        const auto id = dispatcher.connect([&](double) {
+            is_running = true;
+            is_running.notify_all();
+            is_released.wait(false);
+        }, BackPressure::block, 2);
+
+        std::jthread producer{[&] {
+            const std::vector<double> temps(1'000, 23.88);
+            dispatcher.post(temps);
+            is_posted = true;
+        }};
+
+        is_running.wait(false);
+        std::this_thread::sleep_for(10ms); // the producer is blocked by the full ring buffer
+
+        std::jthread releaser{[&] {
+            std::this_thread::sleep_for(10ms);
+            is_released = true;
+            is_released.notify_all();
+        }};
+        REQUIRE(dispatcher.disconnect(id));
+
+        for (int i = 0; i < 500 && !is_posted; ++i)
+            std::this_thread::sleep_for(10ms);
+        REQUIRE(is_posted);
+    }
+
+    SECTION("disconnect called by a handler")
+    {
+        std::atomic<int> calls{0};
+        Signals::connection_id id{};
+        std::atomic<bool> is_connected{false};
+
+        id = dispatcher.connect([&](double) {
+            is_connected.wait(false);
+            ++calls;
+            dispatcher.disconnect(id);
+        });
+        is_connected = true;
+        is_connected.notify_all();
+
+        monitor.temp_changed.emit(1.0);
+        monitor.temp_changed.emit(2.0);
+        dispatcher.wait_idle();
+
+        REQUIRE(calls >= 1);
+        REQUIRE(dispatcher.stats(id) == std::nullopt);
+    }
+}
+
+TEST_CASE("signal vs. async_dispatcher - slow subscribers", "[.][benchmark]")
+{
+    using Signals::BackPressure;
+
+    constexpr int notifications_count = 20'000;
+    constexpr int subscribers_count = 10;
+
+    auto slow_logger = [](double) {
+        const auto start = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() - start < 2us)
+        {
+        }
+    };
+
+    // time of the producer - async_dispatcher delivers notifications later
+    Benchmark::measure("signal<double>::emit (synchronous)", [&] {
+        Signals::signal<double> temp_changed;
+        for (int i = 0; i < subscribers_count; ++i)
+            temp_changed.connect(slow_logger);
+
+        for (int i = 0; i < notifications_count; ++i)
+            temp_changed.emit(i);
+    });
+
+    for (auto policy : {BackPressure::block, BackPressure::drop_oldest, BackPressure::coalesce_latest})
+    {
+        Signals::async_dispatcher<double> dispatcher{4};
+        std::vector<Signals::connection_id> ids;
+        for (int i = 0; i < subscribers_count; ++i)
+            ids.push_back(dispatcher.connect(slow_logger, policy, 256));
+
+        const char* policy_names[] = {"block", "drop_oldest", "coalesce_latest"};
+        Benchmark::measure("async_dispatcher - "s + policy_names[static_cast<int>(policy)], [&] {
+            for (int i = 0; i < notifications_count; ++i)
+                dispatcher.post(i);
+        });
+
+        dispatcher.wait_idle();
+        const auto stats = dispatcher.stats(ids.front()).value();
+        std::cout << "  subscriber #1: delivered " << stats.delivered << ", dropped " << stats.dropped
+                  << ", coalesced " << stats.coalesced << ", latency mean " << stats.mean_latency.count() / 1000
+                  << "us, max " << stats.max_latency.count() / 1000 << "us\n";
+    }
+}
+
+TEST_CASE("Observer vs. signal - 1M notifications to 100 subscribers", "[.][benchmark]")
+{
+    constexpr int notifications_count = 1'000'000;
+    constexpr int subscribers_count = 100;
+
+    struct CountingObserver : Observer
+    {
+        size_t count{};
+
+        void update(const std::any& sender, const std::string& msg) override
+        {
+            count += std::any_cast<TempMonitor*>(&sender) != nullptr && !msg.empty();
+        }
+    };
+
+    Benchmark::measure("Observer + std::any + std::to_string", [&] {
+        TempMonitor monitor;
+        std::vector<CountingObserver> observers(subscribers_count);
+        std::vector<Observer*> observers_ptrs;
+        for (auto& o : observers)
+            observers_ptrs.push_back(&o);
+
+        for (int i = 0; i < notifications_count; ++i)
+        {
+            const double temp = 20.0 + i % 10; // notify() of TempMonitor
+            for (const auto& o : observers_ptrs)
+                o->update(&monitor, std::to_string(temp));
+        }
+
+        return std::accumulate(observers.begin(), observers.end(), size_t{}, [](size_t sum, const auto& o) { return sum + o.count; });
+    }, " deliveries");
+
+    Benchmark::measure("signal<double>::emit                ", [&] {
+        TypedEvents::TempMonitor monitor;
+        std::vector<TypedEvents::Logger> loggers(subscribers_count);
+        for (auto& logger : loggers)
+            monitor.temp_changed.connect<&TypedEvents::Logger::on_temp_changed>(logger);
+
+        for (int i = 0; i < notifications_count; ++i)
+            monitor.temp_changed.emit(20.0 + i % 10);
+
+        return std::accumulate(loggers.begin(), loggers.end(), size_t{}, [](size_t sum, const auto& l) { return sum + l.count; });
+    }, " deliveries");
+
+    Benchmark::measure("signal<double>::queue (batches)     ", [&] {
+        TypedEvents::TempMonitor monitor;
+        std::vector<TypedEvents::Statistics> stats(subscribers_count);
+        for (auto& s : stats)
+            monitor.temp_changed.connect<&TypedEvents::Statistics::on_temp_batch>(s);
+
+        for (int i = 0; i < notifications_count; ++i)
+            monitor.read_sensor(20.0 + i % 10);
+        monitor.temp_changed.flush();
+
+        return stats.size() * notifications_count * (stats[0].sum > 0);
+    }, " deliveries");
+}
+
 
 /////////////////////////////////////////////////////////////////
 // std::optional
@@ -272,6 +981,84 @@ TEST_CASE("value_or")
 	std::cout << maybe_getenv("PATHS").value_or("(not found)") << "\n";
 }
 
+TEST_CASE("environment snapshot")
+{
+    using namespace Environment::Literals;
+
+    char name[] = "PATH=/usr/bin";
+    char home[] = "HOME=/home/jan";
+    char duplicated[] = "PATH=/bin";
+    char empty[] = "EMPTY=";
+    char invalid[] = "INVALID";
+    char* vars[] = {name, home, duplicated, empty, invalid, nullptr};
+
+    const Environment::Snapshot env{vars};
+
+    REQUIRE(env.size() == 3);
+    REQUIRE(env.get("PATH") == "/usr/bin");
+    REQUIRE(env.get("HOME"_env) == "/home/jan");
+    REQUIRE(env.get("EMPTY") == "");
+    REQUIRE(env.get("INVALID") == std::nullopt);
+    REQUIRE(env.get("PATHS"_env) == std::nullopt);
+
+    SECTION("compile-time hashed keys")
+    {
+        static_assert("HOME"_env.hash == Environment::hash("HOME"));
+    }
+
+    SECTION("empty environment")
+    {
+        char* no_vars[] = {nullptr};
+        const Environment::Snapshot empty_env{no_vars};
+
+        REQUIRE(empty_env.size() == 0);
+        REQUIRE(empty_env.get("PATH") == std::nullopt);
+    }
+
+    SECTION("process environment")
+    {
+        REQUIRE(Environment::get("PATHS").value_or("(not found)") == "(not found)");
+
+        if (const char* path = std::getenv("PATH"))
+            REQUIRE(Environment::get("PATH"_env) == path);
+    }
+
+    SECTION("snapshot is not affected by setenv")
+    {
+        setenv("ENV_SNAPSHOT_TEST", "1", 1);
+        REQUIRE(Environment::get("ENV_SNAPSHOT_TEST") == std::nullopt);
+        unsetenv("ENV_SNAPSHOT_TEST");
+    }
+}
+
+TEST_CASE("environment snapshot - benchmark", "[.][benchmark]")
+{
+    using namespace Environment::Literals;
+
+    const size_t lookups = 10'000'000;
+
+    Benchmark::measure("maybe_getenv", [&] {
+        size_t found = 0;
+        for (size_t i = 0; i < lookups; ++i)
+            found += maybe_getenv("PATH").has_value();
+        return found;
+    }, " found");
+
+    Benchmark::measure("Environment::get(std::string_view)", [&] {
+        size_t found = 0;
+        for (size_t i = 0; i < lookups; ++i)
+            found += Environment::get("PATH").has_value();
+        return found;
+    }, " found");
+
+    Benchmark::measure("Environment::get(\"PATH\"_env)", [&] {
+        size_t found = 0;
+        for (size_t i = 0; i < lookups; ++i)
+            found += Environment::get("PATH"_env).has_value();
+        return found;
+    }, " found");
+}
+
 TEST_CASE("move semantics - beware")
 {
 	std::optional<std::string> opt_name = "Jan";
@@ -304,6 +1091,284 @@ TEST_CASE("optional - weird cases")
 	}
 }
 
+enum class Sensor : uint8_t
+{
+    temperature,
+    pressure,
+    humidity
+};
+
+enum LegacyStatus // no fixed underlying type - an explicit sentinel must be in the range of the enum
+{
+    ok,
+    failed,
+    none
+};
+
+TEST_CASE("compact_optional")
+{
+    using CompactOptional::compact_optional;
+
+    static_assert(CompactOptional::Details::EnumWithFixedUnderlyingType<Sensor>);
+    static_assert(!CompactOptional::Details::EnumWithFixedUnderlyingType<LegacyStatus>);
+    static_assert(sizeof(compact_optional<LegacyStatus, LegacyStatus::none>) == sizeof(LegacyStatus));
+
+    static_assert(sizeof(std::optional<int*>) == 2 * sizeof(int*));
+    static_assert(sizeof(compact_optional<int*>) == sizeof(int*));
+    static_assert(sizeof(compact_optional<int, -1>) == sizeof(int));
+    static_assert(sizeof(compact_optional<bool>) == sizeof(bool));
+    static_assert(sizeof(compact_optional<Sensor>) == sizeof(Sensor));
+
+    compact_optional<int, std::numeric_limits<int>::min()> opt_int;
+    REQUIRE(opt_int.has_value() == false);
+
+    opt_int = 42;
+    REQUIRE(opt_int.has_value() == true);
+
+    opt_int = std::nullopt;
+    REQUIRE(opt_int.has_value() == false);
+
+    SECTION("construction in-place")
+    {
+        compact_optional<int, -1> opt_size{std::in_place, 10};
+        REQUIRE(*opt_size == 10);
+    }
+
+    SECTION("using compact_optional")
+    {
+        opt_int = 42;
+
+        if (opt_int)
+            REQUIRE(*opt_int == 42);
+
+        *opt_int = 665;
+
+        REQUIRE(opt_int.value() == 665);
+        REQUIRE(opt_int.value_or(0) == 665);
+
+        opt_int.reset();
+
+        REQUIRE_THROWS_AS(opt_int.value(), std::bad_optional_access);
+        REQUIRE(opt_int.value_or(0) == 0);
+    }
+
+    SECTION("sentinel can't be stored")
+    {
+        REQUIRE_THROWS_AS(opt_int = std::numeric_limits<int>::min(), std::invalid_argument);
+    }
+
+    SECTION("weird cases - the same as std::optional")
+    {
+        compact_optional<bool> flag{false};
+
+        REQUIRE(flag.has_value());
+        REQUIRE(flag == false);
+        flag.reset();
+        REQUIRE(flag == std::nullopt);
+
+        compact_optional<int*> ptr{nullptr};
+
+        REQUIRE(ptr.has_value());
+        REQUIRE(ptr == nullptr);
+        ptr.reset();
+        REQUIRE_FALSE(ptr.has_value());
+
+        compact_optional<Sensor> sensor = Sensor::humidity;
+        REQUIRE(sensor == Sensor::humidity);
+        sensor.reset();
+        REQUIRE(sensor.value_or(Sensor::temperature) == Sensor::temperature);
+    }
+}
+
+TEST_CASE("std::optional vs. compact_optional - scan of a column", "[.][benchmark]")
+{
+    constexpr size_t column_size = 10'000'000; // 100M needs ~1.6 GB for both columns of std::optional<int*>
+
+    auto sum = [](const auto& column) {
+        int64_t sum = 0;
+        for (const auto& item : column)
+            if (item)
+                sum += *item;
+        return sum;
+    };
+
+    auto count_not_null_ptrs = [](const auto& column) {
+        size_t count = 0;
+        for (const auto& item : column)
+            count += item.has_value() && *item != nullptr;
+        return count;
+    };
+
+    auto size_of = [](const auto& column) { return Benchmark::megabytes(column.size() * sizeof(column[0])); };
+
+    std::mt19937_64 rnd{665};
+    std::vector<std::optional<int>> optionals(column_size);
+    std::vector<CompactOptional::compact_optional<int, std::numeric_limits<int>::min()>> compact_optionals(column_size);
+    for (size_t i = 0; i < column_size; ++i)
+    {
+        if (rnd() % 4 != 0)
+        {
+            optionals[i] = static_cast<int>(i % 1000);
+            compact_optionals[i] = static_cast<int>(i % 1000);
+        }
+    }
+
+    Benchmark::measure("std::optional<int>            ", [&] { return sum(optionals); }, " sum, ", size_of(optionals), "MB");
+    Benchmark::measure("compact_optional<int, INT_MIN>", [&] { return sum(compact_optionals); }, " sum, ", size_of(compact_optionals), "MB");
+
+    int value = 42;
+    std::vector<std::optional<int*>> optional_ptrs(column_size);
+    std::vector<CompactOptional::compact_optional<int*>> compact_optional_ptrs(column_size);
+    for (size_t i = 0; i < column_size; ++i)
+    {
+        if (optionals[i])
+        {
+            optional_ptrs[i] = i % 2 ? &value : nullptr;
+            compact_optional_ptrs[i] = i % 2 ? &value : nullptr;
+        }
+    }
+
+    Benchmark::measure("std::optional<int*>           ", [&] { return count_not_null_ptrs(optional_ptrs); }, " count, ",
+        size_of(optional_ptrs), "MB");
+    Benchmark::measure("compact_optional<int*>        ", [&] { return count_not_null_ptrs(compact_optional_ptrs); }, " count, ",
+        size_of(compact_optional_ptrs), "MB");
+}
+
+TEST_CASE("nullable_column - values & validity bitmap")
+{
+    using NullableColumn::nullable_column;
+
+    nullable_column<int> column = {1, std::nullopt, 3, std::nullopt, 5};
+
+    REQUIRE(column.size() == 5);
+    REQUIRE(column.null_count() == 2);
+    REQUIRE(column.validity()[0] == 0b10101);
+
+    SECTION("element proxies behave like std::optional")
+    {
+        REQUIRE(column[0].has_value());
+        REQUIRE(*column[0] == 1);
+        REQUIRE(column[1].has_value() == false);
+        REQUIRE(column[1].value_or(-1) == -1);
+        REQUIRE_THROWS_AS(column[1].value(), std::bad_optional_access);
+
+        column[1] = 2;
+        REQUIRE(column[1] == 2);
+
+        column[0].reset();
+        REQUIRE(column[0] == std::nullopt);
+
+        const auto& const_column = column;
+        std::optional<int> item = const_column[2];
+        REQUIRE(item == 3);
+    }
+
+    SECTION("aggregations skip nulls")
+    {
+        REQUIRE(column.sum() == 9);
+        REQUIRE(column.mean() == 3.0);
+        REQUIRE(column.min() == 1);
+        REQUIRE(column.max() == 5);
+
+        REQUIRE(nullable_column<int>(10).max() == std::nullopt);
+    }
+
+    SECTION("the same results as std::vector<std::optional<T>>")
+    {
+        std::mt19937_64 rnd{665};
+
+        std::vector<std::optional<double>> optionals;
+        nullable_column<double> doubles;
+        nullable_column<int> ints;
+
+        for (int i = 0; i < 10'000; ++i)
+        {
+            const bool is_null = i < 640 ? rnd() % 2 == 0 : (i < 1280 ? false : rnd() % 10 == 0);
+            const int value = static_cast<int>(rnd() % 2001) - 1000;
+
+            optionals.push_back(is_null ? std::nullopt : std::optional<double>(value));
+            doubles.push_back(optionals.back());
+            ints.push_back(is_null ? std::nullopt : std::optional<int>(value));
+        }
+
+        double expected_sum = 0.0;
+        double expected_min = std::numeric_limits<double>::max();
+        double expected_max = std::numeric_limits<double>::lowest();
+        for (const auto& item : optionals)
+            if (item)
+            {
+                expected_sum += *item;
+                expected_min = std::min(expected_min, *item);
+                expected_max = std::max(expected_max, *item);
+            }
+
+        REQUIRE(doubles.sum() == expected_sum);
+        REQUIRE(ints.sum() == static_cast<int64_t>(expected_sum));
+        REQUIRE(doubles.min() == expected_min);
+        REQUIRE(ints.min() == static_cast<int>(expected_min));
+        REQUIRE(doubles.max() == expected_max);
+        REQUIRE(ints.max() == static_cast<int>(expected_max));
+    }
+
+    SECTION("min & max ignore zeros stored in null elements")
+    {
+        nullable_column<double> positives;
+        nullable_column<int> negatives;
+
+        for (int i = 0; i < 256; ++i)
+        {
+            positives.push_back(i % 3 == 0 ? std::nullopt : std::optional<double>(1000 - i));
+            negatives.push_back(i % 5 == 0 ? std::nullopt : std::optional<int>(-1000 + i));
+        }
+
+        REQUIRE(positives.min() == 1000 - 254);
+        REQUIRE(positives.max() == 1000 - 1);
+        REQUIRE(negatives.min() == -1000 + 1);
+        REQUIRE(negatives.max() == -1000 + 254);
+    }
+}
+
+TEST_CASE("std::vector<std::optional<double>> vs. nullable_column<double>", "[.][benchmark]")
+{
+    constexpr size_t column_size = 10'000'000;
+
+    std::mt19937_64 rnd{665};
+    std::vector<std::optional<double>> optionals;
+    NullableColumn::nullable_column<double> column;
+    optionals.reserve(column_size);
+    column.reserve(column_size);
+
+    for (size_t i = 0; i < column_size; ++i)
+    {
+        const std::optional<double> item = rnd() % 10 == 0 ? std::nullopt : std::optional<double>(i % 1000);
+        optionals.push_back(item);
+        column.push_back(item);
+    }
+
+    const size_t optionals_mb = Benchmark::megabytes(optionals.size() * sizeof(optionals[0]));
+    const size_t column_mb = Benchmark::megabytes(column.values().size_bytes() + column.validity().size_bytes());
+
+    Benchmark::measure("std::vector<std::optional<double>>", [&] {
+        double sum = 0.0;
+        for (const auto& item : optionals)
+            if (item)
+                sum += *item;
+        return sum;
+    }, ", ", optionals_mb, "MB");
+
+    Benchmark::measure("nullable_column<double>::sum     ", [&] { return column.sum(); }, ", ", column_mb, "MB");
+
+    Benchmark::measure("std::vector<std::optional<double>> - min", [&] {
+        double min = std::numeric_limits<double>::infinity();
+        for (const auto& item : optionals)
+            if (item)
+                min = std::min(min, *item);
+        return min;
+    }, ", ", optionals_mb, "MB");
+
+    Benchmark::measure("nullable_column<double>::min           ", [&] { return column.min().value(); }, ", ", column_mb, "MB");
+}
+
 std::optional<int> to_int(std::string_view str)
 {
 	int value{};
@@ -336,6 +1401,213 @@ TEST_CASE("to_int")
 	}
 }
 
+std::optional<double> to_double(std::string_view str)
+{
+    double value{};
+
+    if (!FloatParser::parse_double(str, value))
+        return std::nullopt;
+
+    return value;
+}
+
+TEST_CASE("to_double")
+{
+    SECTION("happy path")
+    {
+        REQUIRE(to_double("3.14") == 3.14);
+        REQUIRE(to_double("-1e-5") == -1e-5);
+        REQUIRE(to_double("1.7976931348623157e308") == 1.7976931348623157e308);
+        REQUIRE(to_double("123456789012345678901234567890") == 123456789012345678901234567890.0); // fallback
+    }
+
+    SECTION("sad path")
+    {
+        REQUIRE(to_double("3.14abc").has_value() == false);
+        REQUIRE(to_double("").has_value() == false);
+        REQUIRE(to_double("1e").has_value() == false);
+        REQUIRE(to_double("1e400").has_value() == false);
+    }
+
+    SECTION("the same results as std::from_chars")
+    {
+        std::mt19937_64 rnd{665};
+        std::uniform_int_distribution<int> precision_distr{1, 17};
+
+        for (int i = 0; i < 100'000; ++i)
+        {
+            const double expected = std::bit_cast<double>(rnd());
+            if (!std::isfinite(expected) || expected == 0.0 || std::fabs(expected) < 1e-307)
+                continue;
+
+            std::array<char, 64> buffer;
+            const auto [end, error_code] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), expected,
+                std::chars_format::general, precision_distr(rnd));
+            const std::string_view text(buffer.data(), end - buffer.data());
+
+            double from_chars_value{};
+            std::from_chars(text.data(), text.data() + text.size(), from_chars_value);
+
+            INFO(text);
+            REQUIRE(std::bit_cast<uint64_t>(*to_double(text)) == std::bit_cast<uint64_t>(from_chars_value));
+        }
+    }
+}
+
+TEST_CASE("parse_doubles - batch parsing of floating-point columns")
+{
+    using namespace FloatParser;
+
+    std::string_view csv = "3.14,-0.5,1e10\n2.5e-3,abc,,42";
+
+    std::vector<double> values(IntParser::count_fields(csv));
+    std::vector<uint64_t> errors(IntParser::error_bitmap_size(values.size()));
+
+    REQUIRE(parse_doubles(csv, values, errors) == 7);
+    REQUIRE(values == std::vector{3.14, -0.5, 1e10, 2.5e-3, 0.0, 0.0, 42.0});
+    REQUIRE(errors[0] == 0b0110000);
+
+    std::vector<double> parallel(values.size());
+    std::vector<uint64_t> parallel_errors(errors.size());
+    REQUIRE(parse_doubles_parallel(csv, parallel, parallel_errors, 3) == 7);
+    REQUIRE(parallel == values);
+    REQUIRE(parallel_errors == errors);
+}
+
+TEST_CASE("to_double vs. std::from_chars vs. std::stod", "[.][benchmark]")
+{
+    std::mt19937_64 rnd{665};
+    std::uniform_real_distribution<double> mantissa_distr{-10.0, 10.0};
+    std::uniform_int_distribution<int> exponent_distr{-30, 30};
+    std::uniform_int_distribution<int> precision_distr{1, 17};
+
+    std::string csv;
+    std::vector<std::string_view> fields;
+    while (csv.size() < 64 * 1024 * 1024)
+    {
+        std::array<char, 64> buffer;
+        const double value = mantissa_distr(rnd) * std::pow(10.0, exponent_distr(rnd));
+        const auto [end, error_code] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value,
+            std::chars_format::general, precision_distr(rnd));
+        csv.append(buffer.data(), end).push_back('\n');
+    }
+
+    for (auto token : Tokenizer::tokenize(csv, "\n"))
+        fields.push_back(token);
+
+    std::vector<double> values(fields.size());
+    std::vector<uint64_t> errors(IntParser::error_bitmap_size(fields.size()));
+
+    std::cout << Benchmark::megabytes(csv.size()) << "MB, " << fields.size() << " values\n";
+
+    Benchmark::measure("std::stod                          ", [&] {
+        for (size_t i = 0; i < fields.size(); ++i)
+            values[i] = std::stod(std::string(fields[i]));
+    });
+
+    Benchmark::measure("std::from_chars                    ", [&] {
+        for (size_t i = 0; i < fields.size(); ++i)
+            std::from_chars(fields[i].data(), fields[i].data() + fields[i].size(), values[i]);
+    });
+
+    Benchmark::measure("to_double                          ", [&] {
+        for (size_t i = 0; i < fields.size(); ++i)
+            values[i] = to_double(fields[i]).value_or(0.0);
+    });
+
+    Benchmark::measure("FloatParser::parse_doubles         ", [&] { FloatParser::parse_doubles(csv, values, errors); });
+
+    Benchmark::measure("FloatParser::parse_doubles_parallel", [&] { FloatParser::parse_doubles_parallel(csv, values, errors); });
+}
+
+TEST_CASE("parse_ints - batch parsing of integer columns")
+{
+    using namespace IntParser;
+
+    SECTION("values & errors in a bitmap")
+    {
+        std::string_view csv = "42,-7,12345678,2147483647,-000000000002147483648\n2147483648,42abc,,1234567x9,0";
+
+        std::vector<int> values(count_fields(csv));
+        std::vector<uint64_t> errors(error_bitmap_size(values.size()));
+
+        REQUIRE(parse_ints(csv, values, errors) == 10);
+        REQUIRE(values == std::vector{42, -7, 12345678, 2147483647, std::numeric_limits<int>::min(), 0, 0, 0, 0, 0});
+        REQUIRE(errors[0] == 0b0111100000);
+    }
+
+    SECTION("trailing delimiter doesn't start a new field")
+    {
+        REQUIRE(count_fields("1,2,3\n") == 3);
+        REQUIRE(count_fields("") == 0);
+    }
+
+    SECTION("the same results as to_int - serial & parallel")
+    {
+        std::mt19937_64 rnd{665};
+        std::uniform_int_distribution<int> values_distr{std::numeric_limits<int>::min(), std::numeric_limits<int>::max()};
+        std::uniform_int_distribution<int> kind_distr{0, 9};
+
+        std::string csv;
+        std::vector<std::string> fields;
+        for (int i = 0; i < 10'000; ++i)
+        {
+            std::string field = std::to_string(values_distr(rnd) >> kind_distr(rnd) * 3);
+            if (kind_distr(rnd) == 0)
+                field[field.size() / 2] = 'x';
+            if (kind_distr(rnd) == 0)
+                field += "0000";
+
+            fields.push_back(field);
+            csv += field + (i % 10 == 9 ? '\n' : ',');
+        }
+
+        std::vector<int> serial(fields.size());
+        std::vector<int> parallel(fields.size());
+        std::vector<uint64_t> serial_errors(error_bitmap_size(fields.size()));
+        std::vector<uint64_t> parallel_errors(error_bitmap_size(fields.size()));
+
+        REQUIRE(parse_ints(csv, serial, serial_errors) == fields.size());
+        REQUIRE(parse_ints_parallel(csv, parallel, parallel_errors, 7) == fields.size());
+
+        for (size_t i = 0; i < fields.size(); ++i)
+        {
+            const bool has_error = (serial_errors[i / 64] >> (i % 64)) & 1;
+            REQUIRE(has_error == !to_int(fields[i]).has_value());
+            REQUIRE(serial[i] == to_int(fields[i]).value_or(0));
+        }
+
+        REQUIRE(parallel == serial);
+        REQUIRE(parallel_errors == serial_errors);
+    }
+}
+
+TEST_CASE("parse_ints vs. to_int", "[.][benchmark]")
+{
+    std::mt19937_64 rnd{665};
+    std::uniform_int_distribution<int> values_distr{-1'000'000'000, 1'000'000'000};
+
+    std::string csv;
+    while (csv.size() < 64 * 1024 * 1024)
+        csv += std::to_string(values_distr(rnd)) + ',';
+
+    const size_t count = IntParser::count_fields(csv);
+    std::vector<int> values(count);
+    std::vector<uint64_t> errors(IntParser::error_bitmap_size(count));
+
+    std::cout << Benchmark::megabytes(csv.size()) << "MB, " << count << " values\n";
+
+    Benchmark::measure("to_int + Tokenizer            ", [&] {
+        size_t i = 0;
+        for (auto token : Tokenizer::tokenize(csv, ","))
+            values[i++] = to_int(token).value_or(0);
+    });
+
+    Benchmark::measure("IntParser::parse_ints         ", [&] { IntParser::parse_ints(csv, values, errors); });
+
+    Benchmark::measure("IntParser::parse_ints_parallel", [&] { IntParser::parse_ints_parallel(csv, values, errors); });
+}
+
 ////////////////////////////////////////////////////////////////
 // std::variant
 
@@ -456,6 +1728,155 @@ TEST_CASE("visiting variants")
 	std::visit(local_printer, v1);
 }
 
+TEST_CASE("fast_visit")
+{
+	using FastVisit::fast_visit;
+
+	std::variant<int, double, std::string, std::vector<int>> v1 = std::vector{1, 2, 3};
+
+	auto type_name = overloaded {
+		[](int) { return "int"s; },
+		[](double) { return "double"s; },
+		[](const std::string&) { return "string"s; },
+		[](const std::vector<int>&) { return "vector"s; }
+	};
+
+	REQUIRE(fast_visit(type_name, v1) == std::visit(type_name, v1));
+
+	v1 = 3.14;
+	REQUIRE(fast_visit(type_name, v1) == "double");
+
+	auto identity = [](auto x) { return x; };
+	static_assert(!FastVisit::Details::has_same_results_v<decltype(identity)&, std::variant<int, double>&>); // rejected like by std::visit
+	static_assert(FastVisit::Details::has_same_results_v<decltype(type_name)&, decltype(v1)&>);
+
+	SECTION("many variants")
+	{
+		std::variant<int, double> a = 2.5;
+		std::variant<int, std::string, double> b = "text"s;
+		std::variant<char, int> c = 'x';
+
+		REQUIRE(fast_visit([](const auto&... values) { return sizeof...(values); }, a, b, c) == 3);
+		REQUIRE(fast_visit(overloaded { [](double, const std::string& s, char c) { return s + c; },
+			                            [](const auto&...) { return "?"s; } }, a, b, c) == "textx");
+
+		for (int i = 0; i < 2; ++i)
+			for (int j = 0; j < 3; ++j)
+			{
+				a = i == 0 ? decltype(a){1} : decltype(a){1.0};
+				b = j == 0 ? decltype(b){1} : j == 1 ? decltype(b){"s"} : decltype(b){1.0};
+				auto id = [](const auto& x, const auto& y) { return std::string{typeid(x).name()} + typeid(y).name(); };
+				REQUIRE(fast_visit(id, a, b) == std::visit(id, a, b));
+			}
+	}
+
+	SECTION("rvalue variants are forwarded")
+	{
+		std::variant<int, std::string> v = "moved"s;
+
+		std::string target = fast_visit(overloaded { [](int) { return ""s; },
+			                                         [](std::string&& s) { return std::move(s); } }, std::move(v));
+
+		REQUIRE(target == "moved");
+		REQUIRE(std::get<std::string>(v).empty());
+	}
+
+	SECTION("valueless variant")
+	{
+		struct Throwing
+		{
+			Throwing(int) { throw std::runtime_error{"error"}; }
+			Throwing(const Throwing&) {}
+		};
+
+		std::variant<std::string, Throwing> v;
+		REQUIRE_THROWS(v.emplace<Throwing>(1));
+		REQUIRE(v.valueless_by_exception());
+
+		REQUIRE_THROWS_AS(fast_visit([](const auto&) {}, v), std::bad_variant_access);
+	}
+}
+
+template <size_t I>
+struct Alternative
+{
+	int value;
+};
+
+template <size_t... Is>
+auto make_alternatives(std::index_sequence<Is...>) -> std::variant<Alternative<Is>...>;
+
+template <size_t N>
+using Alternatives = decltype(make_alternatives(std::make_index_sequence<N>{}));
+
+TEST_CASE("fast_visit - variant with 40 alternatives")
+{
+	Alternatives<40> v = Alternative<37>{2};
+
+	auto weight = []<size_t I>(const Alternative<I>& a) { return a.value * static_cast<int>(I); };
+
+	REQUIRE(FastVisit::fast_visit(weight, v) == 74);
+
+	Alternatives<8> other = Alternative<5>{3};
+	REQUIRE(FastVisit::fast_visit([&](const auto& a, const auto& b) { return weight(a) + weight(b); }, v, other) == 89);
+}
+
+TEST_CASE("std::visit vs. fast_visit", "[.][benchmark]")
+{
+	constexpr size_t count = 10'000'000;
+
+	auto weight = []<size_t I>(const Alternative<I>& a) -> int64_t { return a.value * static_cast<int64_t>(I + 1); };
+
+	auto make_random_variants = []<size_t N>(std::integral_constant<size_t, N>) {
+		static const auto factories = []<size_t... Is>(std::index_sequence<Is...>) {
+			return std::array<Alternatives<N> (*)(int), N>{[](int value) -> Alternatives<N> { return Alternative<Is>{value}; }...};
+		}(std::make_index_sequence<N>{});
+
+		std::mt19937_64 rnd{665};
+		std::vector<Alternatives<N>> variants;
+		variants.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+			variants.push_back(factories[rnd() % N](static_cast<int>(i % 100)));
+		return variants;
+	};
+
+	auto run = [&]<size_t N>(std::integral_constant<size_t, N> size) {
+		const auto variants = make_random_variants(size);
+
+		std::cout << "\n" << N << " alternatives:\n";
+		Benchmark::measure("  std::visit ", [&] {
+			int64_t sum = 0;
+			for (const auto& v : variants)
+				sum += std::visit(weight, v);
+			return sum;
+		});
+		Benchmark::measure("  fast_visit ", [&] {
+			int64_t sum = 0;
+			for (const auto& v : variants)
+				sum += FastVisit::fast_visit(weight, v);
+			return sum;
+		});
+
+		std::cout << N << "x" << N << " alternatives (two variants):\n";
+		Benchmark::measure("  std::visit ", [&] {
+			int64_t sum = 0;
+			for (size_t i = 1; i < variants.size(); ++i)
+				sum += std::visit([&](const auto& a, const auto& b) { return weight(a) - weight(b); }, variants[i - 1], variants[i]);
+			return sum;
+		});
+		Benchmark::measure("  fast_visit ", [&] {
+			int64_t sum = 0;
+			for (size_t i = 1; i < variants.size(); ++i)
+				sum += FastVisit::fast_visit([&](const auto& a, const auto& b) { return weight(a) - weight(b); }, variants[i - 1], variants[i]);
+			return sum;
+		});
+	};
+
+	run(std::integral_constant<size_t, 2>{});
+	run(std::integral_constant<size_t, 8>{});
+	run(std::integral_constant<size_t, 32>{});
+}
+
 struct Lambda_74352376452654
 {
 	Lambda_74352376452654() = default;